@@ -30,3 +30,8 @@
 #pragma once
 
 #include "JoystickController/JoystickController.hpp"
+#include "JoystickController/InputHistory.hpp"
+#include "JoystickController/InputSampler.hpp"
+#include "JoystickController/StickGesture.hpp"
+#include "JoystickController/VirtualControllerPool.hpp"
+#include "JoystickController/JoystickSnapshot.hpp"
@@ -0,0 +1,72 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Joystick Controller (https://github.com/Hapaxia/JoystickController
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace joystickcontroller
+{
+
+enum class MathMode
+{
+	Precise, // standard library (std::atan2 and std::sqrt)
+	Fast, // polynomial approximations (see fastmath)
+};
+
+// define JOYSTICKCONTROLLER_FAST_MATH to make Fast the default mode for direction and strength
+#ifdef JOYSTICKCONTROLLER_FAST_MATH
+constexpr MathMode defaultMathMode{ MathMode::Fast };
+#else // JOYSTICKCONTROLLER_FAST_MATH
+constexpr MathMode defaultMathMode{ MathMode::Precise };
+#endif // JOYSTICKCONTROLLER_FAST_MATH
+
+namespace fastmath
+{
+
+// maximum absolute error of 1.2e-5 radians (under 0.001 degrees)
+float atan2(float y, float x);
+
+// maximum relative error of 0.18% (one Newton-Raphson step) so strength is within 0.002 of the precise value; zero and negative values return zero
+float reciprocalSqrt(float value);
+float sqrt(float value);
+
+// batch versions for many sticks at once; inputs are calibrated axis positions (-100 to 100)
+// results match JoystickController's getAxis2dDirectionCustomAxisPair (in radians) and getAxis2dStrengthCustomAxisPair (0 to 1)
+// written without branches (selects are done on the bits) so that the compiler can vectorise the loops with default floating-point flags (e.g. GCC at -O3)
+void computeDirections(const float* positionsX, const float* positionsY, float* directions, std::size_t count);
+void computeStrengths(const float* positionsX, const float* positionsY, float* strengths, std::size_t count);
+
+} // namespace fastmath
+
+} // namespace
+
+#include "FastMath.inl"
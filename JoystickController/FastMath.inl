@@ -0,0 +1,128 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Joystick Controller (https://github.com/Hapaxia/JoystickController
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include <cmath>
+#include <cstring>
+
+#include "FastMath.hpp"
+
+namespace joystickcontroller
+{
+
+namespace fastmath
+{
+
+// selects are done on the bits (rather than with ?:) so that compilers can vectorise loops
+// even when floating-point exceptions must be preserved (e.g. GCC's default -ftrapping-math)
+
+inline std::uint32_t priv_getBits(const float value)
+{
+	std::uint32_t bits{};
+	std::memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+inline float priv_getFloat(const std::uint32_t bits)
+{
+	float value{};
+	std::memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+inline float priv_select(const std::uint32_t mask, const float ifSet, const float ifClear)
+{
+	// mask must be all ones or all zeroes
+	return priv_getFloat((priv_getBits(ifSet) & mask) | (priv_getBits(ifClear) & ~mask));
+}
+
+inline std::uint32_t priv_getMask(const bool condition)
+{
+	return 0u - static_cast<std::uint32_t>(condition);
+}
+
+inline float atan2(const float y, const float x)
+{
+	// octant reduction to [0, 1] then arctangent polynomial from Abramowitz & Stegun 4.4.49 (|error| <= 1e-5)
+	// maximum absolute error (including float rounding) is 1.2e-5 radians, under 0.001 degrees
+	// signs are taken from the sign bits (rather than comparisons) so that signed zeros match std::atan2
+	constexpr float piFloat{ 3.141592653f };
+	constexpr float halfPiFloat{ piFloat / 2.f };
+
+	const std::uint32_t xBits{ priv_getBits(x) };
+	const std::uint32_t yBits{ priv_getBits(y) };
+	const float absX{ priv_getFloat(xBits & 0x7FFFFFFFu) };
+	const float absY{ priv_getFloat(yBits & 0x7FFFFFFFu) };
+	const std::uint32_t isSteep{ priv_getMask(absY > absX) };
+	const float max{ priv_select(isSteep, absY, absX) };
+	const float min{ priv_select(isSteep, absX, absY) };
+	const float a{ min / priv_select(priv_getMask(max > 0.f), max, 1.f) }; // min is also zero when max is zero
+	const float s{ a * a };
+	float r{ a * (0.9998660f + s * (-0.3302995f + s * (0.1801410f + s * (-0.0851330f + s * 0.0208351f)))) };
+	r = priv_select(isSteep, halfPiFloat - r, r);
+	r = priv_select(0u - (xBits >> 31u), piFloat - r, r);
+	return priv_getFloat(priv_getBits(r) ^ (yBits & 0x80000000u));
+}
+
+inline float reciprocalSqrt(const float value)
+{
+	// initial estimate from the bits then one Newton-Raphson step
+	// maximum relative error is 0.18%; zero and negative values return zero
+	float r{ priv_getFloat(0x5F375A86u - (priv_getBits(value) >> 1u)) };
+	r *= 1.5f - 0.5f * value * r * r;
+	return priv_select(priv_getMask(value > 0.f), r, 0.f);
+}
+
+inline float sqrt(const float value)
+{
+	// maximum relative error is 0.18% (see reciprocalSqrt)
+	return value * reciprocalSqrt(value);
+}
+
+inline void computeDirections(const float* const positionsX, const float* const positionsY, float* const directions, const std::size_t count)
+{
+	constexpr float halfPiFloat{ 3.141592653f / 2.f };
+	for (std::size_t i{ 0u }; i < count; ++i)
+		directions[i] = atan2(positionsX[i], -positionsY[i]) - halfPiFloat;
+}
+
+inline void computeStrengths(const float* const positionsX, const float* const positionsY, float* const strengths, const std::size_t count)
+{
+	for (std::size_t i{ 0u }; i < count; ++i)
+	{
+		const float strength{ sqrt(positionsX[i] * positionsX[i] + positionsY[i] * positionsY[i]) * 0.01f };
+		strengths[i] = priv_select(priv_getMask(strength > 1.f), 1.f, strength);
+	}
+}
+
+} // namespace fastmath
+
+} // namespace joystickcontroller
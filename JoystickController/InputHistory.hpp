@@ -0,0 +1,100 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Joystick Controller (https://github.com/Hapaxia/JoystickController
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include <array>
+#include <vector>
+#include <cstdint>
+
+#include "JoystickController.hpp"
+
+namespace joystickcontroller
+{
+
+// a single frame of input for one joystick
+// axes are calibrated positions (-100 to 100) quantised to 8 bits; buttons are a bitmask (bit n is button n)
+struct InputFrame
+{
+	std::uint64_t buttons{ 0u };
+	std::uint32_t frameNumber{ 0u };
+	std::array<std::int8_t, 8u> axes{};
+};
+
+// fixed-size ring of recent input frames for one joystick (for prediction and rollback)
+// frames can be accessed randomly by frame number while they remain within the ring
+// the first and last frame numbers are always held but frames between them may be missing if frames were skipped (see hasFrame)
+// frames can be encoded into (and decoded from) a compact byte buffer, each frame stored as a delta of the previous one
+class InputHistory
+{
+public:
+	InputHistory(std::size_t capacity = 240u);
+
+	void record(const JoystickController& joystickController, std::size_t joystickIndex, std::uint32_t frameNumber);
+	void push(const InputFrame& frame);
+	void clear();
+
+	std::size_t getCapacity() const;
+	bool isEmpty() const;
+	std::uint32_t getFirstFrameNumber() const;
+	std::uint32_t getLastFrameNumber() const;
+	bool hasFrame(std::uint32_t frameNumber) const;
+	const InputFrame& getFrame(std::uint32_t frameNumber) const;
+
+	bool encode(std::uint32_t firstFrameNumber, std::uint32_t lastFrameNumber, std::vector<std::uint8_t>& buffer) const;
+	std::size_t decode(const std::uint8_t* data, std::size_t size);
+	std::size_t decode(const std::vector<std::uint8_t>& buffer);
+
+	static std::int8_t quantiseAxisPosition(float axisPosition);
+	static float dequantiseAxisPosition(std::int8_t quantisedAxisPosition);
+	static float getAxisPosition(const InputFrame& frame, Axis axis);
+	static bool isButtonPressed(const InputFrame& frame, std::size_t buttonIndex);
+
+
+
+private:
+	static constexpr std::size_t maxButtonCount{ 64u };
+	static constexpr std::size_t encodedHeaderSize{ 6u };
+
+	std::vector<InputFrame> m_frames;
+	std::uint32_t m_firstFrameNumber;
+	std::uint32_t m_lastFrameNumber;
+	bool m_isEmpty;
+
+
+
+	std::size_t priv_getFrameSlot(std::uint32_t frameNumber) const;
+	void priv_invalidateFrames();
+	std::size_t priv_decode(const std::uint8_t* data, std::size_t size, bool pushFrames);
+};
+
+} // namespace
+
+#include "InputHistory.inl"
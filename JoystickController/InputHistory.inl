@@ -0,0 +1,341 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Joystick Controller (https://github.com/Hapaxia/JoystickController
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include <assert.h>
+#include <cmath>
+#include <algorithm>
+
+#include "InputHistory.hpp"
+
+namespace joystickcontroller
+{
+
+// ENCODING FORMAT
+//
+// header:
+//	4 bytes - first frame number (little-endian)
+//	2 bytes - number of frames (little-endian)
+//
+// each frame (deltas are from the previous frame; the first frame's deltas are from an empty frame):
+//	1 byte  - flags: bit 0 marks that an axis mask follows; bit 1 marks that a button mask follows
+//	1 byte  - (only if flag bit 0 is set) axis mask: bit n marks that axis n changed
+//	n bytes - one delta (new - old, wrapping) for each changed axis, in axis order
+//	1 byte  - (only if flag bit 1 is set) button mask: bit n marks that byte n of the (64-bit) button bitmask changed
+//	n bytes - one XOR for each changed button byte, in byte order
+//
+// a frame with no changes takes a single byte
+
+inline InputHistory::InputHistory(const std::size_t capacity)
+	: m_frames(capacity)
+	, m_firstFrameNumber{ 0u }
+	, m_lastFrameNumber{ 0u }
+	, m_isEmpty{ true }
+{
+	assert(capacity > 0u);
+
+	priv_invalidateFrames();
+}
+
+inline void InputHistory::record(const JoystickController& joystickController, const std::size_t joystickIndex, const std::uint32_t frameNumber)
+{
+	InputFrame frame{};
+	frame.frameNumber = frameNumber;
+	for (std::size_t a{ 0u }; a < frame.axes.size(); ++a)
+		frame.axes[a] = quantiseAxisPosition(joystickController.getAxisPosition(joystickIndex, static_cast<Axis>(a)));
+	const std::size_t numberOfButtons{ std::min(joystickController.getButtonCount(joystickIndex), maxButtonCount) };
+	for (std::size_t b{ 0u }; b < numberOfButtons; ++b)
+	{
+		if (joystickController.isButtonPressed(joystickIndex, b))
+			frame.buttons |= std::uint64_t{ 1u } << b;
+	}
+	push(frame);
+}
+
+inline void InputHistory::push(const InputFrame& frame)
+{
+	const std::uint32_t capacity{ static_cast<std::uint32_t>(m_frames.size()) };
+	if (m_isEmpty)
+	{
+		m_firstFrameNumber = frame.frameNumber;
+		m_lastFrameNumber = frame.frameNumber;
+		m_isEmpty = false;
+	}
+	else if (frame.frameNumber > m_lastFrameNumber)
+	{
+		m_lastFrameNumber = frame.frameNumber;
+		if (m_lastFrameNumber - m_firstFrameNumber >= capacity)
+			m_firstFrameNumber = m_lastFrameNumber - capacity + 1u;
+	}
+	else if (frame.frameNumber < m_firstFrameNumber)
+	{
+		// older than everything stored; only keep it if it still fits in the ring
+		if (m_lastFrameNumber - frame.frameNumber >= capacity)
+			return;
+		m_firstFrameNumber = frame.frameNumber;
+	}
+	m_frames[priv_getFrameSlot(frame.frameNumber)] = frame;
+
+	// if frames were skipped, the first frame number must still be a frame that is held
+	while ((m_firstFrameNumber < m_lastFrameNumber) && (m_frames[priv_getFrameSlot(m_firstFrameNumber)].frameNumber != m_firstFrameNumber))
+		++m_firstFrameNumber;
+}
+
+inline void InputHistory::clear()
+{
+	m_firstFrameNumber = 0u;
+	m_lastFrameNumber = 0u;
+	m_isEmpty = true;
+	priv_invalidateFrames();
+}
+
+inline std::size_t InputHistory::getCapacity() const
+{
+	return m_frames.size();
+}
+
+inline bool InputHistory::isEmpty() const
+{
+	return m_isEmpty;
+}
+
+inline std::uint32_t InputHistory::getFirstFrameNumber() const
+{
+	return m_firstFrameNumber;
+}
+
+inline std::uint32_t InputHistory::getLastFrameNumber() const
+{
+	return m_lastFrameNumber;
+}
+
+inline bool InputHistory::hasFrame(const std::uint32_t frameNumber) const
+{
+	// frames may have been skipped when pushed so the slot must also match
+	if (m_isEmpty || (frameNumber < m_firstFrameNumber) || (frameNumber > m_lastFrameNumber))
+		return false;
+	return m_frames[priv_getFrameSlot(frameNumber)].frameNumber == frameNumber;
+}
+
+inline const InputFrame& InputHistory::getFrame(const std::uint32_t frameNumber) const
+{
+	assert(hasFrame(frameNumber));
+
+	return m_frames[priv_getFrameSlot(frameNumber)];
+}
+
+inline bool InputHistory::encode(const std::uint32_t firstFrameNumber, const std::uint32_t lastFrameNumber, std::vector<std::uint8_t>& buffer) const
+{
+	// appends to buffer; fails (leaving buffer untouched) if any frame in the range is not available
+	if (lastFrameNumber < firstFrameNumber)
+		return false;
+	const std::uint32_t numberOfFrames{ lastFrameNumber - firstFrameNumber + 1u };
+	if (numberOfFrames > 0xFFFFu)
+		return false;
+	for (std::uint32_t f{ firstFrameNumber }; f <= lastFrameNumber; ++f)
+	{
+		if (!hasFrame(f))
+			return false;
+	}
+
+	buffer.reserve(buffer.size() + encodedHeaderSize + numberOfFrames * 19u);
+	buffer.push_back(static_cast<std::uint8_t>(firstFrameNumber));
+	buffer.push_back(static_cast<std::uint8_t>(firstFrameNumber >> 8u));
+	buffer.push_back(static_cast<std::uint8_t>(firstFrameNumber >> 16u));
+	buffer.push_back(static_cast<std::uint8_t>(firstFrameNumber >> 24u));
+	buffer.push_back(static_cast<std::uint8_t>(numberOfFrames));
+	buffer.push_back(static_cast<std::uint8_t>(numberOfFrames >> 8u));
+
+	InputFrame previous{};
+	for (std::uint32_t f{ firstFrameNumber }; f <= lastFrameNumber; ++f)
+	{
+		const InputFrame& frame{ m_frames[priv_getFrameSlot(f)] };
+
+		std::uint8_t axisMask{ 0u };
+		for (std::size_t a{ 0u }; a < frame.axes.size(); ++a)
+		{
+			if (frame.axes[a] != previous.axes[a])
+				axisMask |= static_cast<std::uint8_t>(1u << a);
+		}
+		const std::uint64_t buttonChanges{ frame.buttons ^ previous.buttons };
+		std::uint8_t buttonMask{ 0u };
+		for (std::size_t b{ 0u }; b < 8u; ++b)
+		{
+			if ((buttonChanges >> (b * 8u)) & 0xFFu)
+				buttonMask |= static_cast<std::uint8_t>(1u << b);
+		}
+		std::uint8_t flags{ 0u };
+		if (axisMask != 0u)
+			flags |= 0x01u;
+		if (buttonMask != 0u)
+			flags |= 0x02u;
+
+		buffer.push_back(flags);
+		if (axisMask != 0u)
+		{
+			buffer.push_back(axisMask);
+			for (std::size_t a{ 0u }; a < frame.axes.size(); ++a)
+			{
+				if (axisMask & (1u << a))
+					buffer.push_back(static_cast<std::uint8_t>(static_cast<std::uint8_t>(frame.axes[a]) - static_cast<std::uint8_t>(previous.axes[a])));
+			}
+		}
+		if (buttonMask != 0u)
+		{
+			buffer.push_back(buttonMask);
+			for (std::size_t b{ 0u }; b < 8u; ++b)
+			{
+				if (buttonMask & (1u << b))
+					buffer.push_back(static_cast<std::uint8_t>(buttonChanges >> (b * 8u)));
+			}
+		}
+
+		previous = frame;
+	}
+	return true;
+}
+
+inline std::size_t InputHistory::decode(const std::uint8_t* const data, const std::size_t size)
+{
+	// pushes each decoded frame and returns the number of bytes consumed (zero if the data is incomplete or malformed)
+	// the data is fully validated before any frame is pushed
+	if (priv_decode(data, size, false) == 0u)
+		return 0u;
+	return priv_decode(data, size, true);
+}
+
+inline std::size_t InputHistory::decode(const std::vector<std::uint8_t>& buffer)
+{
+	return decode(buffer.data(), buffer.size());
+}
+
+inline std::int8_t InputHistory::quantiseAxisPosition(const float axisPosition)
+{
+	if (axisPosition >= 100.f)
+		return 100;
+	if (axisPosition <= -100.f)
+		return -100;
+	return static_cast<std::int8_t>(std::lround(axisPosition));
+}
+
+inline float InputHistory::dequantiseAxisPosition(const std::int8_t quantisedAxisPosition)
+{
+	return static_cast<float>(quantisedAxisPosition);
+}
+
+inline float InputHistory::getAxisPosition(const InputFrame& frame, const Axis axis)
+{
+	return dequantiseAxisPosition(frame.axes[static_cast<std::size_t>(axis)]);
+}
+
+inline bool InputHistory::isButtonPressed(const InputFrame& frame, const std::size_t buttonIndex)
+{
+	if (buttonIndex >= maxButtonCount)
+		return false;
+	return (frame.buttons & (std::uint64_t{ 1u } << buttonIndex)) != 0u;
+}
+
+
+
+
+
+
+
+// PRIVATE
+
+inline std::size_t InputHistory::priv_getFrameSlot(const std::uint32_t frameNumber) const
+{
+	return static_cast<std::size_t>(frameNumber % m_frames.size());
+}
+
+inline void InputHistory::priv_invalidateFrames()
+{
+	// each slot is given a frame number that can never be stored in that slot so that hasFrame cannot match stale data
+	// (a ring with a single slot always holds exactly the last frame pushed so needs no invalidation)
+	for (std::size_t s{ 0u }; s < m_frames.size(); ++s)
+		m_frames[s].frameNumber = static_cast<std::uint32_t>(s + 1u);
+}
+
+inline std::size_t InputHistory::priv_decode(const std::uint8_t* const data, const std::size_t size, const bool pushFrames)
+{
+	if ((data == nullptr) || (size < encodedHeaderSize))
+		return 0u;
+
+	const std::uint32_t firstFrameNumber{ static_cast<std::uint32_t>(data[0u]) | (static_cast<std::uint32_t>(data[1u]) << 8u) | (static_cast<std::uint32_t>(data[2u]) << 16u) | (static_cast<std::uint32_t>(data[3u]) << 24u) };
+	const std::uint32_t numberOfFrames{ static_cast<std::uint32_t>(data[4u]) | (static_cast<std::uint32_t>(data[5u]) << 8u) };
+
+	std::size_t position{ encodedHeaderSize };
+	InputFrame frame{};
+	for (std::uint32_t f{ 0u }; f < numberOfFrames; ++f)
+	{
+		if (position >= size)
+			return 0u;
+		const std::uint8_t flags{ data[position++] };
+		if (flags & 0xFCu)
+			return 0u;
+		if (flags & 0x01u)
+		{
+			if (position >= size)
+				return 0u;
+			const std::uint8_t axisMask{ data[position++] };
+			for (std::size_t a{ 0u }; a < frame.axes.size(); ++a)
+			{
+				if (axisMask & (1u << a))
+				{
+					if (position >= size)
+						return 0u;
+					frame.axes[a] = static_cast<std::int8_t>(static_cast<std::uint8_t>(static_cast<std::uint8_t>(frame.axes[a]) + data[position++]));
+				}
+			}
+		}
+		if (flags & 0x02u)
+		{
+			if (position >= size)
+				return 0u;
+			const std::uint8_t buttonMask{ data[position++] };
+			for (std::size_t b{ 0u }; b < 8u; ++b)
+			{
+				if (buttonMask & (1u << b))
+				{
+					if (position >= size)
+						return 0u;
+					frame.buttons ^= static_cast<std::uint64_t>(data[position++]) << (b * 8u);
+				}
+			}
+		}
+		frame.frameNumber = firstFrameNumber + f;
+		if (pushFrames)
+			push(frame);
+	}
+	return position;
+}
+
+} // namespace joystickcontroller
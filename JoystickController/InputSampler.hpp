@@ -0,0 +1,100 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Joystick Controller (https://github.com/Hapaxia/JoystickController
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include <array>
+#include <vector>
+#include <SFML/System/Time.hpp>
+
+#include "JoystickController.hpp"
+
+namespace joystickcontroller
+{
+
+// small ring of timestamped (calibrated) axis samples for one joystick
+// allows axis positions to be read at any time (e.g. a fixed simulation time) rather than at the time of polling:
+// - between samples, positions are interpolated linearly
+// - after the newest sample, positions are extrapolated linearly for a short time (see setMaxExtrapolation) and then held
+// - before the oldest sample, the oldest sample is held
+// timestamps must be monotonic (e.g. from an sf::Clock); a sample older than the newest sample is ignored and one with the same timestamp replaces it
+class InputSampler
+{
+public:
+	InputSampler(std::size_t capacity = 16u);
+
+	void record(const JoystickController& joystickController, std::size_t joystickIndex, sf::Time timestamp);
+	void push(sf::Time timestamp, const std::array<float, 8u>& axisPositions);
+	void clear();
+
+	std::size_t getCapacity() const;
+	std::size_t getSampleCount() const;
+	sf::Time getOldestTimestamp() const;
+	sf::Time getNewestTimestamp() const;
+
+	void setMaxExtrapolation(sf::Time maxExtrapolation);
+	sf::Time getMaxExtrapolation() const;
+
+	std::array<float, 8u> getAxisPositionsAt(sf::Time time) const;
+	float getAxisPositionAt(Axis axis, sf::Time time) const;
+	sf::Vector2f getAxis2dPositionAt(AxisPair axisPair, sf::Time time, bool invertX = false, bool invertY = false) const;
+	sf::Vector2f getAxis2dPositionCustomAxisPairAt(Axis axisX, Axis axisY, sf::Time time, bool invertX = false, bool invertY = false) const;
+
+
+
+private:
+	struct Sample
+	{
+		sf::Time timestamp{};
+		std::array<float, 8u> axes{};
+	};
+
+	struct Blend
+	{
+		std::size_t from{ 0u };
+		std::size_t to{ 0u };
+		float weight{ 0.f };
+	};
+
+	std::vector<Sample> m_samples;
+	std::size_t m_newestSlot;
+	std::size_t m_numberOfSamples;
+	sf::Time m_maxExtrapolation;
+
+
+
+	std::size_t priv_getSlot(std::size_t age) const;
+	Blend priv_getBlend(sf::Time time) const;
+	float priv_getBlendedAxisPosition(const Blend& blend, std::size_t axisIndex) const;
+};
+
+} // namespace
+
+#include "InputSampler.inl"
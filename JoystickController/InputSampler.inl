@@ -0,0 +1,231 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Joystick Controller (https://github.com/Hapaxia/JoystickController
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include <assert.h>
+
+#include "InputSampler.hpp"
+
+namespace joystickcontroller
+{
+
+inline InputSampler::InputSampler(const std::size_t capacity)
+	: m_samples(capacity)
+	, m_newestSlot{ 0u }
+	, m_numberOfSamples{ 0u }
+	, m_maxExtrapolation{ sf::milliseconds(50) }
+{
+	assert(capacity > 1u);
+}
+
+inline void InputSampler::record(const JoystickController& joystickController, const std::size_t joystickIndex, const sf::Time timestamp)
+{
+	std::array<float, 8u> axisPositions{};
+	for (std::size_t a{ 0u }; a < axisPositions.size(); ++a)
+		axisPositions[a] = joystickController.getAxisPosition(joystickIndex, static_cast<Axis>(a));
+	push(timestamp, axisPositions);
+}
+
+inline void InputSampler::push(const sf::Time timestamp, const std::array<float, 8u>& axisPositions)
+{
+	// older samples are dropped so that the ring stays in timestamp order; a sample with the same timestamp replaces the newest
+	if ((m_numberOfSamples > 0u) && (timestamp < m_samples[m_newestSlot].timestamp))
+		return;
+	if ((m_numberOfSamples == 0u) || (timestamp > m_samples[m_newestSlot].timestamp))
+	{
+		m_newestSlot = (m_newestSlot + 1u) % m_samples.size();
+		if (m_numberOfSamples < m_samples.size())
+			++m_numberOfSamples;
+	}
+	m_samples[m_newestSlot].timestamp = timestamp;
+	m_samples[m_newestSlot].axes = axisPositions;
+}
+
+inline void InputSampler::clear()
+{
+	m_newestSlot = 0u;
+	m_numberOfSamples = 0u;
+}
+
+inline std::size_t InputSampler::getCapacity() const
+{
+	return m_samples.size();
+}
+
+inline std::size_t InputSampler::getSampleCount() const
+{
+	return m_numberOfSamples;
+}
+
+inline sf::Time InputSampler::getOldestTimestamp() const
+{
+	if (m_numberOfSamples == 0u)
+		return sf::Time::Zero;
+	return m_samples[priv_getSlot(m_numberOfSamples - 1u)].timestamp;
+}
+
+inline sf::Time InputSampler::getNewestTimestamp() const
+{
+	if (m_numberOfSamples == 0u)
+		return sf::Time::Zero;
+	return m_samples[m_newestSlot].timestamp;
+}
+
+inline void InputSampler::setMaxExtrapolation(const sf::Time maxExtrapolation)
+{
+	m_maxExtrapolation = maxExtrapolation;
+}
+
+inline sf::Time InputSampler::getMaxExtrapolation() const
+{
+	return m_maxExtrapolation;
+}
+
+inline std::array<float, 8u> InputSampler::getAxisPositionsAt(const sf::Time time) const
+{
+	// resamples every axis at once (the samples are searched only once)
+
+	std::array<float, 8u> axisPositions{};
+	if (m_numberOfSamples == 0u)
+		return axisPositions;
+
+	const Blend blend{ priv_getBlend(time) };
+	for (std::size_t a{ 0u }; a < axisPositions.size(); ++a)
+		axisPositions[a] = priv_getBlendedAxisPosition(blend, a);
+	return axisPositions;
+}
+
+inline float InputSampler::getAxisPositionAt(const Axis axis, const sf::Time time) const
+{
+	if (m_numberOfSamples == 0u)
+		return 0.f;
+
+	return priv_getBlendedAxisPosition(priv_getBlend(time), static_cast<std::size_t>(axis));
+}
+
+inline sf::Vector2f InputSampler::getAxis2dPositionAt(const AxisPair axisPair, const sf::Time time, const bool invertX, const bool invertY) const
+{
+	switch (axisPair)
+	{
+	case AxisPair::XY:
+		return { getAxis2dPositionCustomAxisPairAt(Axis::X, Axis::Y, time, invertX, invertY) };
+	case AxisPair::UV:
+		return { getAxis2dPositionCustomAxisPairAt(Axis::U, Axis::V, time, invertX, invertY) };
+	case AxisPair::PovXY:
+		return { getAxis2dPositionCustomAxisPairAt(Axis::PovX, Axis::PovY, time, invertX, invertY) };
+	default:
+		return { 0.f, 0.f };
+	}
+}
+
+inline sf::Vector2f InputSampler::getAxis2dPositionCustomAxisPairAt(const Axis axisX, const Axis axisY, const sf::Time time, const bool invertX, const bool invertY) const
+{
+	sf::Vector2f position{ 0.f, 0.f };
+	if (m_numberOfSamples == 0u)
+		return position;
+
+	const Blend blend{ priv_getBlend(time) };
+	position = { priv_getBlendedAxisPosition(blend, static_cast<std::size_t>(axisX)), priv_getBlendedAxisPosition(blend, static_cast<std::size_t>(axisY)) };
+	if (invertX)
+		position.x = -position.x;
+	if (invertY)
+		position.y = -position.y;
+	return position;
+}
+
+
+
+
+
+
+
+// PRIVATE
+
+inline std::size_t InputSampler::priv_getSlot(const std::size_t age) const
+{
+	// age 0 is the newest sample
+	return (m_newestSlot + m_samples.size() - age) % m_samples.size();
+}
+
+inline InputSampler::Blend InputSampler::priv_getBlend(const sf::Time time) const
+{
+	// requires at least one sample
+
+	Blend blend{};
+	blend.from = m_newestSlot;
+	blend.to = m_newestSlot;
+
+	const Sample& newest{ m_samples[m_newestSlot] };
+	if (time >= newest.timestamp)
+	{
+		// extrapolate (for a limited time) from the two newest samples
+		if ((m_numberOfSamples < 2u) || (m_maxExtrapolation <= sf::Time::Zero))
+			return blend;
+		blend.from = priv_getSlot(1u);
+		const sf::Time span{ newest.timestamp - m_samples[blend.from].timestamp };
+		const sf::Time extrapolation{ ((time - newest.timestamp) > m_maxExtrapolation) ? m_maxExtrapolation : (time - newest.timestamp) };
+		blend.weight = 1.f + extrapolation / span;
+		return blend;
+	}
+
+	// search from newest to oldest; the simulation usually reads close to the newest sample
+	for (std::size_t age{ 1u }; age < m_numberOfSamples; ++age)
+	{
+		const std::size_t slot{ priv_getSlot(age) };
+		const Sample& sample{ m_samples[slot] };
+		if (time >= sample.timestamp)
+		{
+			const Sample& next{ m_samples[blend.to] };
+			blend.from = slot;
+			blend.weight = (time - sample.timestamp) / (next.timestamp - sample.timestamp);
+			return blend;
+		}
+		blend.to = slot;
+	}
+
+	// older than the oldest sample
+	blend.from = blend.to;
+	return blend;
+}
+
+inline float InputSampler::priv_getBlendedAxisPosition(const Blend& blend, const std::size_t axisIndex) const
+{
+	const float from{ m_samples[blend.from].axes[axisIndex] };
+	const float to{ m_samples[blend.to].axes[axisIndex] };
+	float n{ from + (to - from) * blend.weight };
+	if (n > 100.f)
+		n = 100.f;
+	else if (n < -100.f)
+		n = -100.f;
+	return n;
+}
+
+} // namespace joystickcontroller
@@ -29,10 +29,16 @@
 
 #pragma once
 
+#include <array>
 #include <vector>
+#include <cstdint>
 #include <SFML/Window/Joystick.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <SFML/System/Angle.hpp>
+#include <SFML/System/Time.hpp>
+#include <SFML/System/Clock.hpp>
+
+#include "FastMath.hpp"
 
 namespace joystickcontroller
 {
@@ -59,10 +65,20 @@ enum class Axis
 class JoystickController
 {
 public:
+	static constexpr std::size_t maxButtonCount{ 64u };
+
 	JoystickController();
 
+	// reads every connected joystick and evaluates its virtual controls; call once per frame (after SFML's events are processed)
+	// all button and axis getters return the state from the most recent update
+	// joysticks connected or disconnected since the previous update are detected here; their state and virtual controls are reset (calibration is kept)
+	// without a delta time, the time since the previous update is measured (used by the ramps of virtual axes)
+	void update();
+	void update(sf::Time deltaTime);
+
 	std::size_t getConnectedCount() const;
 	std::vector<std::size_t> getConnectedIndices() const;
+	bool isConnected(std::size_t joystickIndex) const;
 
 	std::size_t getButtonCount(std::size_t joystickIndex) const;
 	bool getHasAxis(std::size_t joystickIndex, Axis axis) const;
@@ -70,6 +86,8 @@ public:
 	std::vector<Axis> getAxes(std::size_t joystickIndex) const;
 
 	bool isButtonPressed(std::size_t joystickIndex, std::size_t buttonIndex) const;
+	bool isButtonJustPressed(std::size_t joystickIndex, std::size_t buttonIndex) const;
+	bool isButtonJustReleased(std::size_t joystickIndex, std::size_t buttonIndex) const;
 	float getAxisPositionRaw(std::size_t joystickIndex, Axis axis) const;
 	sf::Vector2f getAxis2dPositionRaw(std::size_t joystickIndex, AxisPair axisPair, bool invertX = false, bool invertY = false) const;
 	sf::Vector2f getAxis2dPositionCustomAxisPairRaw(std::size_t joystickIndex, Axis axisX, Axis axisY, bool invertX = false, bool invertY = false) const;
@@ -78,10 +96,10 @@ public:
 	sf::Vector2f getAxis2dPosition(std::size_t joystickIndex, AxisPair axisPair, bool invertX = false, bool invertY = false) const;
 	sf::Vector2f getAxis2dPositionCustomAxisPair(std::size_t joystickIndex, Axis axisX, Axis axisY, bool invertX = false, bool invertY = false) const;
 
-	sf::Angle getAxis2dDirection(std::size_t joystickIndex, AxisPair axisPair, bool invertX = false, bool invertY = false) const;
-	sf::Angle getAxis2dDirectionCustomAxisPair(std::size_t joystickIndex, Axis axisX, Axis axisY, bool invertX = false, bool invertY = false) const;
-	float getAxis2dStrength(std::size_t joystickIndex, AxisPair axisPair) const;
-	float getAxis2dStrengthCustomAxisPair(std::size_t joystickIndex, Axis axisX, Axis axisY) const;
+	sf::Angle getAxis2dDirection(std::size_t joystickIndex, AxisPair axisPair, bool invertX = false, bool invertY = false, MathMode mathMode = defaultMathMode) const;
+	sf::Angle getAxis2dDirectionCustomAxisPair(std::size_t joystickIndex, Axis axisX, Axis axisY, bool invertX = false, bool invertY = false, MathMode mathMode = defaultMathMode) const;
+	float getAxis2dStrength(std::size_t joystickIndex, AxisPair axisPair, MathMode mathMode = defaultMathMode) const;
+	float getAxis2dStrengthCustomAxisPair(std::size_t joystickIndex, Axis axisX, Axis axisY, MathMode mathMode = defaultMathMode) const;
 
 	std::size_t getAxis2dDirectionIndex(std::size_t joystickIndex, AxisPair axisPair, std::size_t numberOfSegments, bool invertX = false, bool invertY = false) const;
 	std::size_t getAxis2dDirectionIndexCustomAxisPair(std::size_t joystickIndex, Axis axisX, Axis axisY, std::size_t numberOfSegments, bool invertX = false, bool invertY = false) const;
@@ -107,9 +125,29 @@ public:
 	float getCalibrationAxisMinNegative(std::size_t joystickIndex, Axis axis) const;
 	float getCalibrationAxisMaxNegative(std::size_t joystickIndex, Axis axis) const;
 
+	std::size_t getCalibrationVersion() const;
+
+
+
+	// virtual buttons are driven by a (calibrated) axis and follow the physical buttons, so the returned button index is at least the physical button count
+	// the joystick must be connected; the index depends on its physical button count when added (virtual controls are removed when it is disconnected)
+	// returns maxButtonCount (never a valid button index) if the joystick is not connected or no button indices remain
+	// a positive press threshold presses at or above it; a negative press threshold presses at or below it
+	// once pressed, the button is released only when the axis passes back beyond the release threshold (hysteresis)
+	std::size_t addVirtualButton(std::size_t joystickIndex, Axis axis, float pressThreshold, float releaseThreshold);
+
+	// virtual axes are driven by a pair of physical buttons and replace the (raw) position of the given axis
+	// ignored if the joystick is not connected or either button index is not a physical button
+	// the position moves towards -100, 0 or 100 taking ramp time to move from 0 to 100 (zero ramp time is immediate)
+	void addVirtualAxis(std::size_t joystickIndex, Axis axis, std::size_t negativeButtonIndex, std::size_t positiveButtonIndex, sf::Time rampTime = sf::Time::Zero);
+
+	void clearVirtualControls(std::size_t joystickIndex);
+
 
 
 private:
+	friend class VirtualControllerPool;
+
 	static constexpr float piFloat{ 3.141592653f };
 	static constexpr float halfPiFloat{ piFloat / 2.f };
 	static constexpr float doublePiFloat{ piFloat * 2.f };
@@ -149,9 +187,41 @@ private:
 	};
 
 	std::vector<Calibration> m_calibrations;
+	std::size_t m_calibrationVersion;
+
+	struct VirtualButton
+	{
+		Axis axis{ Axis::X };
+		float pressThreshold{ 50.f };
+		float releaseThreshold{ 40.f };
+		bool isPressed{ false };
+	};
+
+	struct VirtualAxis
+	{
+		Axis axis{ Axis::X };
+		std::size_t negativeButtonIndex{ 0u };
+		std::size_t positiveButtonIndex{ 0u };
+		sf::Time rampTime{ sf::Time::Zero };
+		float position{ 0.f };
+	};
+
+	struct State
+	{
+		std::size_t numberOfPhysicalButtons{ 0u };
+		std::uint64_t buttons{ 0u };
+		std::uint64_t previousButtons{ 0u };
+		std::array<float, 8u> axes{};
+		std::vector<VirtualButton> virtualButtons{};
+		std::vector<VirtualAxis> virtualAxes{};
+	};
+
+	std::vector<State> m_states;
+	sf::Clock m_updateClock;
 
 
 
+	static float priv_calibrateAxisPosition(float rawPosition, float zero, float minPositive, float maxPositive, float minNegative, float maxNegative);
 	std::size_t priv_getCalibrationIndex(const std::size_t joystickIndex) const;
 	void priv_setCalibrationValue(const std::size_t joystickIndex, const Axis axis, const CalibrationField calibrationField, const float newValue);
 	void priv_setCalibrationFieldValue(AxisCalibration& axisCalibration, const CalibrationField calibrationField, const float newValue);
@@ -40,16 +40,90 @@ inline JoystickController::JoystickController()
 	: m_areJoysticksConnected(8u)
 	, m_numberOfConnectedJoysticks{ 0u }
 	, m_calibrations{}
+	, m_calibrationVersion{ 0u }
+	, m_states(8u)
+	, m_updateClock{}
 {
 	sf::Joystick::update();
-	for (std::size_t j{ 0u }; j < m_areJoysticksConnected.size(); ++j)
+	update(sf::Time::Zero);
+}
+
+inline void JoystickController::update()
+{
+	update(m_updateClock.getElapsedTime());
+}
+
+inline void JoystickController::update(const sf::Time deltaTime)
+{
+	m_updateClock.restart();
+
+	for (std::size_t j{ 0u }; j < m_states.size(); ++j)
 	{
-		if (m_areJoysticksConnected[j] = sf::Joystick::isConnected(static_cast<unsigned int>(j)))
+		const unsigned int sfmlJoystickIndex{ static_cast<unsigned int>(j) };
+		State& state{ m_states[j] };
+
+		// joysticks can be connected or disconnected at any time; state (including virtual controls) does not survive either
+		const bool isJoystickConnected{ sf::Joystick::isConnected(sfmlJoystickIndex) };
+		if (isJoystickConnected != m_areJoysticksConnected[j])
+		{
+			m_areJoysticksConnected[j] = isJoystickConnected;
+			state = State{};
+			if (isJoystickConnected)
+			{
+				++m_numberOfConnectedJoysticks;
+				if (priv_getCalibrationIndex(j) == m_calibrations.size())
+				{
+					Calibration calibration{};
+					calibration.joystickIndex = j;
+					m_calibrations.push_back(calibration);
+				}
+			}
+			else
+				--m_numberOfConnectedJoysticks;
+		}
+		if (!isJoystickConnected)
+			continue;
+
+		state.previousButtons = state.buttons;
+		state.buttons = 0u;
+		state.numberOfPhysicalButtons = std::min(static_cast<std::size_t>(sf::Joystick::getButtonCount(sfmlJoystickIndex)), maxButtonCount);
+		for (std::size_t b{ 0u }; b < state.numberOfPhysicalButtons; ++b)
+		{
+			if (sf::Joystick::isButtonPressed(sfmlJoystickIndex, static_cast<unsigned int>(b)))
+				state.buttons |= std::uint64_t{ 1u } << b;
+		}
+		for (std::size_t a{ 0u }; a < state.axes.size(); ++a)
+			state.axes[a] = sf::Joystick::getAxisPosition(sfmlJoystickIndex, priv_getSfmlJoystickAxis(static_cast<Axis>(a)));
+
+		// virtual axes (from physical buttons) first so that virtual buttons can also be driven by virtual axes
+		for (VirtualAxis& virtualAxis : state.virtualAxes)
+		{
+			float target{ 0.f };
+			if (state.buttons & (std::uint64_t{ 1u } << virtualAxis.negativeButtonIndex))
+				target -= 100.f;
+			if (state.buttons & (std::uint64_t{ 1u } << virtualAxis.positiveButtonIndex))
+				target += 100.f;
+			if (virtualAxis.rampTime <= sf::Time::Zero)
+				virtualAxis.position = target;
+			else
+			{
+				const float step{ 100.f * deltaTime.asSeconds() / virtualAxis.rampTime.asSeconds() };
+				if (virtualAxis.position < target)
+					virtualAxis.position = std::min(virtualAxis.position + step, target);
+				else if (virtualAxis.position > target)
+					virtualAxis.position = std::max(virtualAxis.position - step, target);
+			}
+			state.axes[static_cast<std::size_t>(virtualAxis.axis)] = virtualAxis.position;
+		}
+
+		for (std::size_t v{ 0u }; v < state.virtualButtons.size(); ++v)
 		{
-			++m_numberOfConnectedJoysticks;
-			Calibration calibration{};
-			calibration.joystickIndex = j;
-			m_calibrations.push_back(calibration);
+			VirtualButton& virtualButton{ state.virtualButtons[v] };
+			const float position{ getAxisPosition(j, virtualButton.axis) };
+			const float threshold{ virtualButton.isPressed ? virtualButton.releaseThreshold : virtualButton.pressThreshold };
+			virtualButton.isPressed = (virtualButton.pressThreshold < 0.f) ? (position <= threshold) : (position >= threshold);
+			if (virtualButton.isPressed && (state.numberOfPhysicalButtons + v < maxButtonCount))
+				state.buttons |= std::uint64_t{ 1u } << (state.numberOfPhysicalButtons + v);
 		}
 	}
 }
@@ -70,13 +144,31 @@ inline std::vector<std::size_t> JoystickController::getConnectedIndices() const
 	return indices;
 }
 
+inline bool JoystickController::isConnected(const std::size_t joystickIndex) const
+{
+	if (joystickIndex >= m_areJoysticksConnected.size())
+		return false;
+	return m_areJoysticksConnected[joystickIndex];
+}
+
 inline std::size_t JoystickController::getButtonCount(const std::size_t joystickIndex) const
 {
-	return sf::Joystick::getButtonCount(static_cast<unsigned int>(joystickIndex));
+	// includes virtual buttons
+	if (joystickIndex >= m_states.size())
+		return 0u;
+	return std::min(m_states[joystickIndex].numberOfPhysicalButtons + m_states[joystickIndex].virtualButtons.size(), maxButtonCount);
 }
 
 inline bool JoystickController::getHasAxis(const std::size_t joystickIndex, const Axis axis) const
 {
+	// includes virtual axes
+	if (joystickIndex >= m_states.size())
+		return false;
+	for (const VirtualAxis& virtualAxis : m_states[joystickIndex].virtualAxes)
+	{
+		if (virtualAxis.axis == axis)
+			return true;
+	}
 	return sf::Joystick::hasAxis(static_cast<unsigned int>(joystickIndex), priv_getSfmlJoystickAxis(axis));
 }
 
@@ -126,12 +218,34 @@ inline std::vector<Axis> JoystickController::getAxes(const std::size_t joystickI
 
 inline bool JoystickController::isButtonPressed(const std::size_t joystickIndex, const std::size_t buttonIndex) const
 {
-	return sf::Joystick::isButtonPressed(static_cast<unsigned int>(joystickIndex), static_cast<unsigned int>(buttonIndex));
+	if ((joystickIndex >= m_states.size()) || (buttonIndex >= maxButtonCount))
+		return false;
+	return (m_states[joystickIndex].buttons & (std::uint64_t{ 1u } << buttonIndex)) != 0u;
+}
+
+inline bool JoystickController::isButtonJustPressed(const std::size_t joystickIndex, const std::size_t buttonIndex) const
+{
+	// pressed during the most recent update
+	if ((joystickIndex >= m_states.size()) || (buttonIndex >= maxButtonCount))
+		return false;
+	const State& state{ m_states[joystickIndex] };
+	return ((state.buttons & ~state.previousButtons) & (std::uint64_t{ 1u } << buttonIndex)) != 0u;
+}
+
+inline bool JoystickController::isButtonJustReleased(const std::size_t joystickIndex, const std::size_t buttonIndex) const
+{
+	// released during the most recent update
+	if ((joystickIndex >= m_states.size()) || (buttonIndex >= maxButtonCount))
+		return false;
+	const State& state{ m_states[joystickIndex] };
+	return ((state.previousButtons & ~state.buttons) & (std::uint64_t{ 1u } << buttonIndex)) != 0u;
 }
 
 inline float JoystickController::getAxisPositionRaw(const std::size_t joystickIndex, const Axis axis) const
 {
-	return sf::Joystick::getAxisPosition(static_cast<unsigned int>(joystickIndex), priv_getSfmlJoystickAxis(axis));
+	if (joystickIndex >= m_states.size())
+		return 0.f;
+	return m_states[joystickIndex].axes[static_cast<std::size_t>(axis)];
 }
 
 inline sf::Vector2f JoystickController::getAxis2dPositionRaw(const std::size_t joystickIndex, const AxisPair axisPair, const bool invertX, const bool invertY) const
@@ -168,11 +282,9 @@ inline float JoystickController::getAxisPosition(const std::size_t joystickIndex
 {
 	// get calibrated position i.e. value is modified dependant on calibration settings
 
-	float n{};
-
 	const Calibration& c{ m_calibrations[priv_getCalibrationIndex(joystickIndex)] };
 
-	const float origValue{ sf::Joystick::getAxisPosition(static_cast<unsigned int>(joystickIndex), priv_getSfmlJoystickAxis(axis)) };
+	const float origValue{ getAxisPositionRaw(joystickIndex, axis) };
 
 	const AxisCalibration* a{ nullptr };
 
@@ -205,37 +317,7 @@ inline float JoystickController::getAxisPosition(const std::size_t joystickIndex
 		break;
 	}
 
-	n = origValue - a->zero;
-	float maxPositive{ a->maxPositive - a->zero };
-	float maxNegative{ a->maxNegative + a->zero };
-	float minPositive{ a->minPositive - a->zero };
-	float minNegative{ a->minNegative + a->zero };
-
-	if (n > 0.f)
-	{
-		if (n < minPositive)
-			n = 0.f;
-		else
-		{
-			n -= minPositive;
-			n *= 100.f / (maxPositive - minPositive);
-		}
-	}
-	else if (n < 0.f)
-	{
-		if (n > minNegative)
-			n = 0.f;
-		else
-		{
-			n -= minNegative;
-			n *= -100.f / (maxNegative - minNegative);
-		}
-	}
-	if (n > 100.f)
-		n = 100.f;
-	else if (n < -100.f)
-		n = -100.f;
-	return n;
+	return priv_calibrateAxisPosition(origValue, a->zero, a->minPositive, a->maxPositive, a->minNegative, a->maxNegative);
 }
 
 inline sf::Vector2f JoystickController::getAxis2dPosition(const std::size_t joystickIndex, const AxisPair axisPair, const bool invertX, const bool invertY) const
@@ -270,50 +352,53 @@ inline sf::Vector2f JoystickController::getAxis2dPositionCustomAxisPair(const st
 
 
 
-inline sf::Angle JoystickController::getAxis2dDirection(const std::size_t joystickIndex, const AxisPair axisPair, const bool invertX, const bool invertY) const
+inline sf::Angle JoystickController::getAxis2dDirection(const std::size_t joystickIndex, const AxisPair axisPair, const bool invertX, const bool invertY, const MathMode mathMode) const
 {
 	switch (axisPair)
 	{
 	case AxisPair::XY:
-		return getAxis2dDirectionCustomAxisPair(joystickIndex, Axis::X, Axis::Y, invertX, invertY);
+		return getAxis2dDirectionCustomAxisPair(joystickIndex, Axis::X, Axis::Y, invertX, invertY, mathMode);
 	case AxisPair::UV:
-		return getAxis2dDirectionCustomAxisPair(joystickIndex, Axis::U, Axis::V, invertX, invertY);
+		return getAxis2dDirectionCustomAxisPair(joystickIndex, Axis::U, Axis::V, invertX, invertY, mathMode);
 	case AxisPair::PovXY:
-		return getAxis2dDirectionCustomAxisPair(joystickIndex, Axis::PovX, Axis::PovY, invertX, invertY);
+		return getAxis2dDirectionCustomAxisPair(joystickIndex, Axis::PovX, Axis::PovY, invertX, invertY, mathMode);
 	default:
 		return sf::Angle::Zero;
 	}
 }
 
-inline sf::Angle JoystickController::getAxis2dDirectionCustomAxisPair(const std::size_t joystickIndex, const Axis axisX, const Axis axisY, const bool invertX, const bool invertY) const
+inline sf::Angle JoystickController::getAxis2dDirectionCustomAxisPair(const std::size_t joystickIndex, const Axis axisX, const Axis axisY, const bool invertX, const bool invertY, const MathMode mathMode) const
 {
 	sf::Vector2f position{ getAxisPosition(joystickIndex, axisX), -getAxisPosition(joystickIndex, axisY) };
 	if (invertX)
 		position.x = -position.x;
 	if (invertY)
 		position.y = -position.y;
+	if (mathMode == MathMode::Fast)
+		return sf::radians(fastmath::atan2(position.x, position.y) - halfPiFloat);
 	return sf::radians(std::atan2(position.x, position.y) - halfPiFloat);
 }
 
-inline float JoystickController::getAxis2dStrength(const std::size_t joystickIndex, const AxisPair axisPair) const
+inline float JoystickController::getAxis2dStrength(const std::size_t joystickIndex, const AxisPair axisPair, const MathMode mathMode) const
 {
 	switch (axisPair)
 	{
 	case AxisPair::XY:
-		return getAxis2dStrengthCustomAxisPair(joystickIndex, Axis::X, Axis::Y);
+		return getAxis2dStrengthCustomAxisPair(joystickIndex, Axis::X, Axis::Y, mathMode);
 	case AxisPair::UV:
-		return getAxis2dStrengthCustomAxisPair(joystickIndex, Axis::U, Axis::V);
+		return getAxis2dStrengthCustomAxisPair(joystickIndex, Axis::U, Axis::V, mathMode);
 	case AxisPair::PovXY:
-		return getAxis2dStrengthCustomAxisPair(joystickIndex, Axis::PovX, Axis::PovY);
+		return getAxis2dStrengthCustomAxisPair(joystickIndex, Axis::PovX, Axis::PovY, mathMode);
 	default:
 		return 0.f;
 	}
 }
 
-inline float JoystickController::getAxis2dStrengthCustomAxisPair(const std::size_t joystickIndex, const Axis axisX, const Axis axisY) const
+inline float JoystickController::getAxis2dStrengthCustomAxisPair(const std::size_t joystickIndex, const Axis axisX, const Axis axisY, const MathMode mathMode) const
 {
 	sf::Vector2f position{ getAxisPosition(joystickIndex, axisX), getAxisPosition(joystickIndex, axisY) };
-	float strength{ std::sqrt(position.x * position.x + position.y * position.y) * 0.01f };
+	const float lengthSquared{ position.x * position.x + position.y * position.y };
+	float strength{ ((mathMode == MathMode::Fast) ? fastmath::sqrt(lengthSquared) : std::sqrt(lengthSquared)) * 0.01f };
 	if (strength < 0.f)
 		strength = 0.f;
 	if (strength > 1.f)
@@ -459,6 +544,67 @@ inline float JoystickController::getCalibrationAxisMaxNegative(std::size_t joyst
 	return priv_getCalibrationValue(joystickIndex, axis, CalibrationField::MaxNegative);
 }
 
+inline std::size_t JoystickController::getCalibrationVersion() const
+{
+	// increases whenever any calibration value is changed
+	return m_calibrationVersion;
+}
+
+
+
+
+
+
+
+// VIRTUAL CONTROLS
+
+
+inline std::size_t JoystickController::addVirtualButton(const std::size_t joystickIndex, const Axis axis, const float pressThreshold, const float releaseThreshold)
+{
+	assert(isConnected(joystickIndex));
+	if (!isConnected(joystickIndex))
+		return maxButtonCount;
+	State& state{ m_states[joystickIndex] };
+	assert(state.numberOfPhysicalButtons + state.virtualButtons.size() < maxButtonCount);
+	if (state.numberOfPhysicalButtons + state.virtualButtons.size() >= maxButtonCount)
+		return maxButtonCount;
+
+	VirtualButton virtualButton{};
+	virtualButton.axis = axis;
+	virtualButton.pressThreshold = pressThreshold;
+	virtualButton.releaseThreshold = releaseThreshold;
+	state.virtualButtons.push_back(virtualButton);
+	return state.numberOfPhysicalButtons + state.virtualButtons.size() - 1u;
+}
+
+inline void JoystickController::addVirtualAxis(const std::size_t joystickIndex, const Axis axis, const std::size_t negativeButtonIndex, const std::size_t positiveButtonIndex, const sf::Time rampTime)
+{
+	assert(isConnected(joystickIndex));
+	if (!isConnected(joystickIndex))
+		return;
+	State& state{ m_states[joystickIndex] };
+	assert(negativeButtonIndex < state.numberOfPhysicalButtons);
+	assert(positiveButtonIndex < state.numberOfPhysicalButtons);
+	if ((negativeButtonIndex >= state.numberOfPhysicalButtons) || (positiveButtonIndex >= state.numberOfPhysicalButtons))
+		return;
+
+	VirtualAxis virtualAxis{};
+	virtualAxis.axis = axis;
+	virtualAxis.negativeButtonIndex = negativeButtonIndex;
+	virtualAxis.positiveButtonIndex = positiveButtonIndex;
+	virtualAxis.rampTime = rampTime;
+	state.virtualAxes.push_back(virtualAxis);
+}
+
+inline void JoystickController::clearVirtualControls(const std::size_t joystickIndex)
+{
+	if (joystickIndex >= m_states.size())
+		return;
+	State& state{ m_states[joystickIndex] };
+	state.virtualButtons.clear();
+	state.virtualAxes.clear();
+}
+
 
 
 
@@ -478,6 +624,41 @@ inline float JoystickController::getCalibrationAxisMaxNegative(std::size_t joyst
 
 // PRIVATE
 
+inline float JoystickController::priv_calibrateAxisPosition(const float rawPosition, const float zero, const float minPositiveValue, const float maxPositiveValue, const float minNegativeValue, const float maxNegativeValue)
+{
+	float n{ rawPosition - zero };
+	float maxPositive{ maxPositiveValue - zero };
+	float maxNegative{ maxNegativeValue + zero };
+	float minPositive{ minPositiveValue - zero };
+	float minNegative{ minNegativeValue + zero };
+
+	if (n > 0.f)
+	{
+		if (n < minPositive)
+			n = 0.f;
+		else
+		{
+			n -= minPositive;
+			n *= 100.f / (maxPositive - minPositive);
+		}
+	}
+	else if (n < 0.f)
+	{
+		if (n > minNegative)
+			n = 0.f;
+		else
+		{
+			n -= minNegative;
+			n *= -100.f / (maxNegative - minNegative);
+		}
+	}
+	if (n > 100.f)
+		n = 100.f;
+	else if (n < -100.f)
+		n = -100.f;
+	return n;
+}
+
 inline std::size_t JoystickController::priv_getCalibrationIndex(const std::size_t joystickIndex) const
 {
 	return static_cast<std::size_t>(std::distance(m_calibrations.begin(), std::find_if(m_calibrations.begin(), m_calibrations.end(), [joystickIndex](const Calibration& c) { return c.joystickIndex == joystickIndex; })));
@@ -486,6 +667,7 @@ inline std::size_t JoystickController::priv_getCalibrationIndex(const std::size_
 inline void JoystickController::priv_setCalibrationValue(const std::size_t joystickIndex, const Axis axis, const CalibrationField calibrationField, const float newValue)
 {
 	Calibration& c{ m_calibrations[priv_getCalibrationIndex(joystickIndex)] };
+	++m_calibrationVersion;
 	switch (axis)
 	{
 	case Axis::X:
@@ -0,0 +1,138 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Joystick Controller (https://github.com/Hapaxia/JoystickController
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <vector>
+#include <cstdint>
+
+#include "JoystickController.hpp"
+
+namespace joystickcontroller
+{
+
+// immutable view of every joystick at the moment it was published (see SnapshotPublisher)
+class JoystickSnapshot
+{
+public:
+	std::size_t getFrameNumber() const;
+	std::size_t getCalibrationVersion() const;
+
+	std::size_t getConnectedCount() const;
+	bool isConnected(std::size_t joystickIndex) const;
+
+	std::uint64_t getButtons(std::size_t joystickIndex) const;
+	bool isButtonPressed(std::size_t joystickIndex, std::size_t buttonIndex) const;
+	float getAxisPositionRaw(std::size_t joystickIndex, Axis axis) const;
+	float getAxisPosition(std::size_t joystickIndex, Axis axis) const;
+	sf::Vector2f getAxis2dPosition(std::size_t joystickIndex, AxisPair axisPair, bool invertX = false, bool invertY = false) const;
+	sf::Vector2f getAxis2dPositionCustomAxisPair(std::size_t joystickIndex, Axis axisX, Axis axisY, bool invertX = false, bool invertY = false) const;
+
+
+
+private:
+	friend class SnapshotPublisher;
+
+	static constexpr std::size_t maxJoystickCount{ 8u };
+	static constexpr std::size_t maxButtonCount{ 64u };
+
+	struct JoystickState
+	{
+		bool isConnected{ false };
+		std::uint64_t buttons{ 0u };
+		std::array<float, 8u> axesRaw{};
+		std::array<float, 8u> axes{};
+	};
+
+	std::size_t m_frameNumber{ 0u };
+	std::size_t m_calibrationVersion{ 0u };
+	std::size_t m_numberOfConnectedJoysticks{ 0u };
+	std::array<JoystickState, maxJoystickCount> m_joysticks{};
+};
+
+// reference to a published snapshot; the snapshot will not be reused while this exists
+// keep it only as long as needed (e.g. for a task) since held snapshots cannot be recycled by the publisher
+class SnapshotReference
+{
+public:
+	SnapshotReference(SnapshotReference&& other) noexcept;
+	SnapshotReference(const SnapshotReference&) = delete;
+	SnapshotReference& operator=(const SnapshotReference&) = delete;
+	SnapshotReference& operator=(SnapshotReference&&) = delete;
+	~SnapshotReference();
+
+	const JoystickSnapshot& operator*() const;
+	const JoystickSnapshot* operator->() const;
+	const JoystickSnapshot* get() const;
+
+
+
+private:
+	friend class SnapshotPublisher;
+
+	SnapshotReference(const JoystickSnapshot* snapshot, std::atomic<std::size_t>* readerCount);
+
+	const JoystickSnapshot* m_snapshot;
+	std::atomic<std::size_t>* m_readerCount;
+};
+
+// publishes snapshots of a JoystickController so that any thread can read input without locking (read-copy-update)
+// only the owner thread (the one that owns the JoystickController) may call publish
+// any thread may call getSnapshot; the snapshot it references is consistent and does not change while referenced
+// snapshots are recycled once no longer referenced; if every other snapshot is still referenced, publish does nothing and returns false
+// max number of references is the most SnapshotReferences that may exist (across all threads) at once, e.g. one per worker thread
+// it holds that many snapshots plus two (the current one and the one being written) so publish always succeeds while the bound is kept
+// calibration changes made to the JoystickController take effect (all at once) from the next publish
+class SnapshotPublisher
+{
+public:
+	SnapshotPublisher(std::size_t maxNumberOfReferences = 2u);
+
+	bool publish(const JoystickController& joystickController);
+	SnapshotReference getSnapshot() const;
+
+
+
+private:
+	std::vector<JoystickSnapshot> m_snapshots;
+	mutable std::vector<std::atomic<std::size_t>> m_readerCounts;
+	std::size_t m_frameNumber;
+	std::atomic<std::size_t> m_currentSnapshot;
+
+
+
+	std::size_t priv_findFreeSnapshot() const;
+};
+
+} // namespace
+
+#include "JoystickSnapshot.inl"
@@ -0,0 +1,247 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Joystick Controller (https://github.com/Hapaxia/JoystickController
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include <algorithm>
+
+#include "JoystickSnapshot.hpp"
+
+namespace joystickcontroller
+{
+
+inline std::size_t JoystickSnapshot::getFrameNumber() const
+{
+	return m_frameNumber;
+}
+
+inline std::size_t JoystickSnapshot::getCalibrationVersion() const
+{
+	return m_calibrationVersion;
+}
+
+inline std::size_t JoystickSnapshot::getConnectedCount() const
+{
+	return m_numberOfConnectedJoysticks;
+}
+
+inline bool JoystickSnapshot::isConnected(const std::size_t joystickIndex) const
+{
+	if (joystickIndex >= maxJoystickCount)
+		return false;
+	return m_joysticks[joystickIndex].isConnected;
+}
+
+inline std::uint64_t JoystickSnapshot::getButtons(const std::size_t joystickIndex) const
+{
+	if (joystickIndex >= maxJoystickCount)
+		return 0u;
+	return m_joysticks[joystickIndex].buttons;
+}
+
+inline bool JoystickSnapshot::isButtonPressed(const std::size_t joystickIndex, const std::size_t buttonIndex) const
+{
+	if (buttonIndex >= maxButtonCount)
+		return false;
+	return (getButtons(joystickIndex) & (std::uint64_t{ 1u } << buttonIndex)) != 0u;
+}
+
+inline float JoystickSnapshot::getAxisPositionRaw(const std::size_t joystickIndex, const Axis axis) const
+{
+	if (joystickIndex >= maxJoystickCount)
+		return 0.f;
+	return m_joysticks[joystickIndex].axesRaw[static_cast<std::size_t>(axis)];
+}
+
+inline float JoystickSnapshot::getAxisPosition(const std::size_t joystickIndex, const Axis axis) const
+{
+	if (joystickIndex >= maxJoystickCount)
+		return 0.f;
+	return m_joysticks[joystickIndex].axes[static_cast<std::size_t>(axis)];
+}
+
+inline sf::Vector2f JoystickSnapshot::getAxis2dPosition(const std::size_t joystickIndex, const AxisPair axisPair, const bool invertX, const bool invertY) const
+{
+	switch (axisPair)
+	{
+	case AxisPair::XY:
+		return { getAxis2dPositionCustomAxisPair(joystickIndex, Axis::X, Axis::Y, invertX, invertY) };
+	case AxisPair::UV:
+		return { getAxis2dPositionCustomAxisPair(joystickIndex, Axis::U, Axis::V, invertX, invertY) };
+	case AxisPair::PovXY:
+		return { getAxis2dPositionCustomAxisPair(joystickIndex, Axis::PovX, Axis::PovY, invertX, invertY) };
+	default:
+		return { 0.f, 0.f };
+	}
+}
+
+inline sf::Vector2f JoystickSnapshot::getAxis2dPositionCustomAxisPair(const std::size_t joystickIndex, const Axis axisX, const Axis axisY, const bool invertX, const bool invertY) const
+{
+	sf::Vector2f position{ 0.f, 0.f };
+	position = { getAxisPosition(joystickIndex, axisX), getAxisPosition(joystickIndex, axisY) };
+	if (invertX)
+		position.x = -position.x;
+	if (invertY)
+		position.y = -position.y;
+	return position;
+}
+
+
+
+
+
+
+
+inline SnapshotReference::SnapshotReference(const JoystickSnapshot* const snapshot, std::atomic<std::size_t>* const readerCount)
+	: m_snapshot{ snapshot }
+	, m_readerCount{ readerCount }
+{
+}
+
+inline SnapshotReference::SnapshotReference(SnapshotReference&& other) noexcept
+	: m_snapshot{ other.m_snapshot }
+	, m_readerCount{ other.m_readerCount }
+{
+	other.m_snapshot = nullptr;
+	other.m_readerCount = nullptr;
+}
+
+inline SnapshotReference::~SnapshotReference()
+{
+	if (m_readerCount != nullptr)
+		m_readerCount->fetch_sub(1u, std::memory_order_release);
+}
+
+inline const JoystickSnapshot& SnapshotReference::operator*() const
+{
+	return *m_snapshot;
+}
+
+inline const JoystickSnapshot* SnapshotReference::operator->() const
+{
+	return m_snapshot;
+}
+
+inline const JoystickSnapshot* SnapshotReference::get() const
+{
+	return m_snapshot;
+}
+
+
+
+
+
+
+
+inline SnapshotPublisher::SnapshotPublisher(const std::size_t maxNumberOfReferences)
+	: m_snapshots(maxNumberOfReferences + 2u)
+	, m_readerCounts(maxNumberOfReferences + 2u)
+	, m_frameNumber{ 0u }
+	, m_currentSnapshot{ 0u }
+{
+	// an empty (nothing connected) snapshot is current before the first publish
+}
+
+inline bool SnapshotPublisher::publish(const JoystickController& joystickController)
+{
+	// owner thread only
+	// the snapshot being written is neither current nor referenced so readers are not affected until it is swapped in
+
+	const std::size_t snapshotIndex{ priv_findFreeSnapshot() };
+	if (snapshotIndex >= m_snapshots.size())
+		return false;
+
+	JoystickSnapshot& snapshot{ m_snapshots[snapshotIndex] };
+	snapshot.m_frameNumber = ++m_frameNumber;
+	snapshot.m_calibrationVersion = joystickController.getCalibrationVersion();
+	snapshot.m_numberOfConnectedJoysticks = 0u;
+	for (std::size_t j{ 0u }; j < JoystickSnapshot::maxJoystickCount; ++j)
+	{
+		JoystickSnapshot::JoystickState& state{ snapshot.m_joysticks[j] };
+		state = JoystickSnapshot::JoystickState{};
+		if (!(state.isConnected = joystickController.isConnected(j)))
+			continue;
+
+		++snapshot.m_numberOfConnectedJoysticks;
+		const std::size_t numberOfButtons{ std::min(joystickController.getButtonCount(j), JoystickSnapshot::maxButtonCount) };
+		for (std::size_t b{ 0u }; b < numberOfButtons; ++b)
+		{
+			if (joystickController.isButtonPressed(j, b))
+				state.buttons |= std::uint64_t{ 1u } << b;
+		}
+		for (std::size_t a{ 0u }; a < state.axes.size(); ++a)
+		{
+			state.axesRaw[a] = joystickController.getAxisPositionRaw(j, static_cast<Axis>(a));
+			state.axes[a] = joystickController.getAxisPosition(j, static_cast<Axis>(a));
+		}
+	}
+
+	m_currentSnapshot.store(snapshotIndex);
+	return true;
+}
+
+inline SnapshotReference SnapshotPublisher::getSnapshot() const
+{
+	// any thread; lock-free
+	// the reader count is raised before checking that the snapshot is still current so that
+	// the publisher either sees the reference (and leaves the snapshot alone) or the reader retries
+
+	for (;;)
+	{
+		const std::size_t snapshotIndex{ m_currentSnapshot.load() };
+		m_readerCounts[snapshotIndex].fetch_add(1u);
+		if (m_currentSnapshot.load() == snapshotIndex)
+			return { &m_snapshots[snapshotIndex], &m_readerCounts[snapshotIndex] };
+		m_readerCounts[snapshotIndex].fetch_sub(1u, std::memory_order_release);
+	}
+}
+
+
+
+
+
+
+
+// PRIVATE
+
+inline std::size_t SnapshotPublisher::priv_findFreeSnapshot() const
+{
+	// returns the number of snapshots if none are free
+	const std::size_t currentSnapshot{ m_currentSnapshot.load(std::memory_order_relaxed) };
+	for (std::size_t s{ 1u }; s < m_snapshots.size(); ++s)
+	{
+		const std::size_t snapshotIndex{ (currentSnapshot + s) % m_snapshots.size() };
+		if (m_readerCounts[snapshotIndex].load() == 0u)
+			return snapshotIndex;
+	}
+	return m_snapshots.size();
+}
+
+} // namespace joystickcontroller
@@ -0,0 +1,129 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Joystick Controller (https://github.com/Hapaxia/JoystickController
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include <SFML/System/Time.hpp>
+
+#include "JoystickController.hpp"
+
+namespace joystickcontroller
+{
+
+enum class GestureEvent
+{
+	None = 0,
+	Activate = 1 << 0, // stick has left the centre
+	Release = 1 << 1, // stick has returned to the centre
+	Flick = 1 << 2, // stick has moved from the centre to the edge quickly
+	RotationClockwise = 1 << 3, // stick has completed a full clockwise turn (since it left the centre)
+	RotationAnticlockwise = 1 << 4, // stick has completed a full anticlockwise turn (since it left the centre)
+	SectorEnter = 1 << 5, // stick has entered a different sector
+	SectorHold = 1 << 6, // stick has been held in the same sector for the hold time
+};
+
+// incremental gesture tracking for a single stick (axis pair) of a joystick
+// update once per poll; events are reported as flags that are valid until the next update
+// angles match getAxis2dDirection (zero is right, positive is clockwise) and sectors match getAxis2dDirectionIndex (zero is up)
+class StickGesture
+{
+public:
+	StickGesture(AxisPair axisPair = AxisPair::XY);
+	StickGesture(Axis axisX, Axis axisY);
+
+	bool update(const JoystickController& joystickController, std::size_t joystickIndex, sf::Time deltaTime);
+	bool update(sf::Vector2f position, sf::Time deltaTime);
+	void reset();
+
+	bool hasEvent(GestureEvent gestureEvent) const;
+	unsigned int getEvents() const;
+
+	bool isActive() const;
+	sf::Vector2f getPosition() const;
+	float getStrength() const;
+	sf::Angle getDirection() const;
+	sf::Angle getRotation() const; // accumulated (unwrapped) rotation since the stick left the centre
+	sf::Angle getAngularVelocity() const; // per second
+	int getSpinCount() const;
+	int getSector() const; // -1 when not active
+	sf::Time getTimeInSector() const;
+	sf::Angle getFlickDirection() const;
+
+	void setActiveStrength(float activeStrength);
+	void setFlickStrength(float flickStrength);
+	void setFlickTime(sf::Time flickTime);
+	void setNumberOfSectors(std::size_t numberOfSectors);
+	void setSectorHoldTime(sf::Time sectorHoldTime); // zero reports a hold on the same update that enters the sector
+
+	float getActiveStrength() const;
+	float getFlickStrength() const;
+	sf::Time getFlickTime() const;
+	std::size_t getNumberOfSectors() const;
+	sf::Time getSectorHoldTime() const;
+
+
+
+private:
+	static constexpr float piFloat{ 3.141592653f };
+	static constexpr float halfPiFloat{ piFloat / 2.f };
+	static constexpr float doublePiFloat{ piFloat * 2.f };
+
+	Axis m_axisX;
+	Axis m_axisY;
+
+	float m_activeStrength;
+	float m_flickStrength;
+	sf::Time m_flickTime;
+	std::size_t m_numberOfSectors;
+	sf::Time m_sectorHoldTime;
+
+	unsigned int m_events;
+	sf::Vector2f m_position;
+	float m_strength;
+	float m_direction;
+	float m_rotation;
+	float m_angularVelocity;
+	int m_spinCount;
+	int m_sector;
+	sf::Time m_timeInSector;
+	bool m_hasHeldSector;
+	sf::Time m_timeActive;
+	bool m_hasFlicked;
+	float m_flickDirection;
+
+
+
+	void priv_addEvent(GestureEvent gestureEvent);
+	int priv_getSector(float direction) const;
+};
+
+} // namespace
+
+#include "StickGesture.inl"
@@ -0,0 +1,331 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Joystick Controller (https://github.com/Hapaxia/JoystickController
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include <assert.h>
+#include <cmath>
+
+#include "StickGesture.hpp"
+
+namespace joystickcontroller
+{
+
+inline StickGesture::StickGesture(const AxisPair axisPair)
+	: StickGesture(Axis::X, Axis::Y)
+{
+	switch (axisPair)
+	{
+	case AxisPair::XY:
+		break;
+	case AxisPair::UV:
+		m_axisX = Axis::U;
+		m_axisY = Axis::V;
+		break;
+	case AxisPair::PovXY:
+		m_axisX = Axis::PovX;
+		m_axisY = Axis::PovY;
+		break;
+	}
+}
+
+inline StickGesture::StickGesture(const Axis axisX, const Axis axisY)
+	: m_axisX{ axisX }
+	, m_axisY{ axisY }
+	, m_activeStrength{ 0.5f }
+	, m_flickStrength{ 0.9f }
+	, m_flickTime{ sf::milliseconds(100) }
+	, m_numberOfSectors{ 8u }
+	, m_sectorHoldTime{ sf::milliseconds(500) }
+	, m_events{ 0u }
+	, m_position{ 0.f, 0.f }
+	, m_strength{ 0.f }
+	, m_direction{ 0.f }
+	, m_rotation{ 0.f }
+	, m_angularVelocity{ 0.f }
+	, m_spinCount{ 0 }
+	, m_sector{ -1 }
+	, m_timeInSector{ sf::Time::Zero }
+	, m_hasHeldSector{ false }
+	, m_timeActive{ sf::Time::Zero }
+	, m_hasFlicked{ false }
+	, m_flickDirection{ 0.f }
+{
+}
+
+inline bool StickGesture::update(const JoystickController& joystickController, const std::size_t joystickIndex, const sf::Time deltaTime)
+{
+	return update(joystickController.getAxis2dPositionCustomAxisPair(joystickIndex, m_axisX, m_axisY), deltaTime);
+}
+
+inline bool StickGesture::update(const sf::Vector2f position, const sf::Time deltaTime)
+{
+	// position is calibrated (-100 to 100 on each axis); returns true if any event occurred
+
+	m_events = 0u;
+
+	const bool wasActive{ isActive() };
+	m_position = position;
+	m_strength = std::sqrt(position.x * position.x + position.y * position.y) * 0.01f;
+	if (m_strength > 1.f)
+		m_strength = 1.f;
+
+	if (m_strength < m_activeStrength)
+	{
+		if (wasActive)
+			priv_addEvent(GestureEvent::Release);
+		m_sector = -1;
+		m_timeInSector = sf::Time::Zero;
+		m_hasHeldSector = false;
+		m_timeActive = sf::Time::Zero;
+		m_rotation = 0.f;
+		m_angularVelocity = 0.f;
+		m_spinCount = 0;
+		m_hasFlicked = false;
+		return m_events != 0u;
+	}
+
+	const float direction{ std::atan2(position.y, position.x) };
+
+	if (!wasActive)
+	{
+		priv_addEvent(GestureEvent::Activate);
+	}
+	else
+	{
+		m_timeActive += deltaTime;
+
+		float deltaDirection{ direction - m_direction };
+		if (deltaDirection > piFloat)
+			deltaDirection -= doublePiFloat;
+		else if (deltaDirection < -piFloat)
+			deltaDirection += doublePiFloat;
+		m_rotation += deltaDirection;
+		m_angularVelocity = (deltaTime > sf::Time::Zero) ? deltaDirection / deltaTime.asSeconds() : 0.f;
+
+		// a spin is reported each time the number of complete turns (in either direction) increases
+		const int spinCount{ static_cast<int>(m_rotation / doublePiFloat) };
+		if (spinCount != m_spinCount)
+		{
+			if (std::abs(spinCount) > std::abs(m_spinCount))
+				priv_addEvent((spinCount > 0) ? GestureEvent::RotationClockwise : GestureEvent::RotationAnticlockwise);
+			m_spinCount = spinCount;
+		}
+	}
+	m_direction = direction;
+
+	if (!m_hasFlicked && (m_strength >= m_flickStrength) && (m_timeActive <= m_flickTime))
+	{
+		m_hasFlicked = true;
+		m_flickDirection = direction;
+		priv_addEvent(GestureEvent::Flick);
+	}
+
+	const int sector{ priv_getSector(direction) };
+	if (sector != m_sector)
+	{
+		m_sector = sector;
+		m_timeInSector = sf::Time::Zero;
+		m_hasHeldSector = false;
+		priv_addEvent(GestureEvent::SectorEnter);
+	}
+	else
+		m_timeInSector += deltaTime;
+
+	// a zero hold time is held on entering the sector
+	if (!m_hasHeldSector && (m_timeInSector >= m_sectorHoldTime))
+	{
+		m_hasHeldSector = true;
+		priv_addEvent(GestureEvent::SectorHold);
+	}
+
+	return m_events != 0u;
+}
+
+inline void StickGesture::reset()
+{
+	m_events = 0u;
+	m_position = { 0.f, 0.f };
+	m_strength = 0.f;
+	m_direction = 0.f;
+	m_rotation = 0.f;
+	m_angularVelocity = 0.f;
+	m_spinCount = 0;
+	m_sector = -1;
+	m_timeInSector = sf::Time::Zero;
+	m_hasHeldSector = false;
+	m_timeActive = sf::Time::Zero;
+	m_hasFlicked = false;
+	m_flickDirection = 0.f;
+}
+
+inline bool StickGesture::hasEvent(const GestureEvent gestureEvent) const
+{
+	return (m_events & static_cast<unsigned int>(gestureEvent)) != 0u;
+}
+
+inline unsigned int StickGesture::getEvents() const
+{
+	return m_events;
+}
+
+inline bool StickGesture::isActive() const
+{
+	return m_sector >= 0;
+}
+
+inline sf::Vector2f StickGesture::getPosition() const
+{
+	return m_position;
+}
+
+inline float StickGesture::getStrength() const
+{
+	return m_strength;
+}
+
+inline sf::Angle StickGesture::getDirection() const
+{
+	return sf::radians(m_direction);
+}
+
+inline sf::Angle StickGesture::getRotation() const
+{
+	return sf::radians(m_rotation);
+}
+
+inline sf::Angle StickGesture::getAngularVelocity() const
+{
+	return sf::radians(m_angularVelocity);
+}
+
+inline int StickGesture::getSpinCount() const
+{
+	return m_spinCount;
+}
+
+inline int StickGesture::getSector() const
+{
+	return m_sector;
+}
+
+inline sf::Time StickGesture::getTimeInSector() const
+{
+	return m_timeInSector;
+}
+
+inline sf::Angle StickGesture::getFlickDirection() const
+{
+	return sf::radians(m_flickDirection);
+}
+
+inline void StickGesture::setActiveStrength(const float activeStrength)
+{
+	m_activeStrength = activeStrength;
+}
+
+inline void StickGesture::setFlickStrength(const float flickStrength)
+{
+	m_flickStrength = flickStrength;
+}
+
+inline void StickGesture::setFlickTime(const sf::Time flickTime)
+{
+	m_flickTime = flickTime;
+}
+
+inline void StickGesture::setNumberOfSectors(const std::size_t numberOfSectors)
+{
+	assert(numberOfSectors > 1u);
+
+	m_numberOfSectors = numberOfSectors;
+}
+
+inline void StickGesture::setSectorHoldTime(const sf::Time sectorHoldTime)
+{
+	m_sectorHoldTime = sectorHoldTime;
+}
+
+inline float StickGesture::getActiveStrength() const
+{
+	return m_activeStrength;
+}
+
+inline float StickGesture::getFlickStrength() const
+{
+	return m_flickStrength;
+}
+
+inline sf::Time StickGesture::getFlickTime() const
+{
+	return m_flickTime;
+}
+
+inline std::size_t StickGesture::getNumberOfSectors() const
+{
+	return m_numberOfSectors;
+}
+
+inline sf::Time StickGesture::getSectorHoldTime() const
+{
+	return m_sectorHoldTime;
+}
+
+
+
+
+
+
+
+// PRIVATE
+
+inline void StickGesture::priv_addEvent(const GestureEvent gestureEvent)
+{
+	m_events |= static_cast<unsigned int>(gestureEvent);
+}
+
+inline int StickGesture::priv_getSector(const float direction) const
+{
+	// same segmentation as JoystickController::getAxis2dDirectionIndex
+	float angle{ direction + halfPiFloat }; // add quarter turn so that first index is straight up
+	while (angle > doublePiFloat)
+		angle -= doublePiFloat;
+	while (angle < 0.f)
+		angle += doublePiFloat;
+
+	constexpr float recipricalOfFullCircle{ 1.f / doublePiFloat };
+	angle *= m_numberOfSectors * recipricalOfFullCircle;
+	std::size_t sector{ static_cast<std::size_t>(std::round(angle)) };
+	if (sector >= m_numberOfSectors)
+		sector -= m_numberOfSectors;
+	return static_cast<int>(sector);
+}
+
+} // namespace joystickcontroller
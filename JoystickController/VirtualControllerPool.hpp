@@ -0,0 +1,173 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Joystick Controller (https://github.com/Hapaxia/JoystickController
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+#include <cstdint>
+
+#include "JoystickController.hpp"
+
+namespace joystickcontroller
+{
+
+// pool of virtual controllers (e.g. for bots and load tests) stored as structure-of-arrays
+// uses the same calibration, deadzone, 2D and POV logic as JoystickController
+// physical joysticks can be copied into the first slots (their joystick indices) with updatePhysical
+// update applies calibration and 2D derivation to the whole pool, split into chunks shared between worker threads
+// the worker threads are owned by the pool and kept between updates; they are only recreated when the number of threads changes
+class VirtualControllerPool
+{
+public:
+	VirtualControllerPool(std::size_t numberOfControllers = 0u);
+	VirtualControllerPool(const VirtualControllerPool&) = delete;
+	VirtualControllerPool& operator=(const VirtualControllerPool&) = delete;
+	~VirtualControllerPool();
+
+	void resize(std::size_t numberOfControllers);
+	std::size_t getSize() const;
+
+	void updatePhysical(const JoystickController& joystickController);
+	void update(std::size_t numberOfThreads = 0u, MathMode mathMode = defaultMathMode);
+
+	// chunk size is rounded up to a whole number of cache lines so that threads never write to the same cache line
+	void setChunkSize(std::size_t chunkSize);
+	std::size_t getChunkSize() const;
+
+	void setAxisPositionRaw(std::size_t controllerIndex, Axis axis, float position);
+	void setButtonPressed(std::size_t controllerIndex, std::size_t buttonIndex, bool isPressed);
+	void setButtons(std::size_t controllerIndex, std::uint64_t buttons);
+
+	void setCalibrationAxisZero(std::size_t controllerIndex, Axis axis, float zeroValue);
+	void setCalibrationAxisMinPositive(std::size_t controllerIndex, Axis axis, float minPositive);
+	void setCalibrationAxisMaxPositive(std::size_t controllerIndex, Axis axis, float maxPositive);
+	void setCalibrationAxisMinNegative(std::size_t controllerIndex, Axis axis, float minNegative);
+	void setCalibrationAxisMaxNegative(std::size_t controllerIndex, Axis axis, float maxNegative);
+
+	bool isButtonPressed(std::size_t controllerIndex, std::size_t buttonIndex) const;
+	std::uint64_t getButtons(std::size_t controllerIndex) const;
+	float getAxisPositionRaw(std::size_t controllerIndex, Axis axis) const;
+
+	// results of the most recent update
+	float getAxisPosition(std::size_t controllerIndex, Axis axis) const;
+	sf::Vector2f getAxis2dPosition(std::size_t controllerIndex, AxisPair axisPair) const;
+	sf::Angle getAxis2dDirection(std::size_t controllerIndex, AxisPair axisPair) const;
+	float getAxis2dStrength(std::size_t controllerIndex, AxisPair axisPair) const;
+	int getAxis2dAsPovHat(std::size_t controllerIndex, AxisPair axisPair) const;
+
+	// contiguous results of the most recent update (one value per controller)
+	const float* getAxisPositions(Axis axis) const;
+	const float* getAxis2dDirections(AxisPair axisPair) const;
+	const float* getAxis2dStrengths(AxisPair axisPair) const;
+
+
+
+private:
+	static constexpr std::size_t numberOfAxes{ 8u };
+	static constexpr std::size_t numberOfAxisPairs{ 3u };
+	static constexpr std::size_t maxButtonCount{ 64u };
+	static constexpr std::size_t cacheLineSize{ 64u };
+	static constexpr std::size_t chunkAlignment{ cacheLineSize / sizeof(float) }; // smallest stored values are 4 bytes (others are 8)
+
+	// storage starts on a cache line so that chunk boundaries (multiples of chunkAlignment) are also on cache lines
+	template <class T>
+	struct CacheLineAllocator
+	{
+		using value_type = T;
+		CacheLineAllocator() = default;
+		template <class U>
+		CacheLineAllocator(const CacheLineAllocator<U>&) noexcept {}
+		T* allocate(std::size_t n) { return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{ cacheLineSize })); }
+		void deallocate(T* p, std::size_t) noexcept { ::operator delete(p, std::align_val_t{ cacheLineSize }); }
+		template <class U>
+		bool operator==(const CacheLineAllocator<U>&) const noexcept { return true; }
+		template <class U>
+		bool operator!=(const CacheLineAllocator<U>&) const noexcept { return false; }
+	};
+
+	template <class T>
+	using AlignedVector = std::vector<T, CacheLineAllocator<T>>;
+
+	struct AxisStorage
+	{
+		AlignedVector<float> raw;
+		AlignedVector<float> position;
+		AlignedVector<float> zero;
+		AlignedVector<float> minPositive;
+		AlignedVector<float> maxPositive;
+		AlignedVector<float> minNegative;
+		AlignedVector<float> maxNegative;
+	};
+
+	struct AxisPairStorage
+	{
+		AlignedVector<float> direction;
+		AlignedVector<float> strength;
+		AlignedVector<int> povHat;
+	};
+
+	std::size_t m_numberOfControllers;
+	std::size_t m_chunkSize;
+	AlignedVector<std::uint64_t> m_buttons;
+	std::array<AxisStorage, numberOfAxes> m_axes;
+	std::array<AxisPairStorage, numberOfAxisPairs> m_axisPairs;
+
+	std::vector<std::thread> m_workers;
+	std::mutex m_workMutex;
+	std::condition_variable m_workStarted;
+	std::condition_variable m_workFinished;
+	std::size_t m_workGeneration;
+	std::size_t m_numberOfBusyWorkers;
+	bool m_isStopping;
+	std::atomic<std::size_t> m_nextChunk;
+	std::size_t m_numberOfChunks;
+	MathMode m_mathMode;
+
+
+
+	void priv_setNumberOfWorkers(std::size_t numberOfWorkers);
+	void priv_stopWorkers();
+	void priv_runWorker(std::size_t workGeneration);
+	void priv_processChunks();
+	void priv_updateRange(std::size_t begin, std::size_t end, MathMode mathMode);
+	static std::size_t priv_getAxisPairIndex(AxisPair axisPair);
+	static Axis priv_getAxisPairAxisX(std::size_t axisPairIndex);
+	static Axis priv_getAxisPairAxisY(std::size_t axisPairIndex);
+};
+
+} // namespace
+
+#include "VirtualControllerPool.inl"
@@ -0,0 +1,439 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Joystick Controller (https://github.com/Hapaxia/JoystickController
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include <assert.h>
+#include <algorithm>
+#include <cmath>
+
+#include "VirtualControllerPool.hpp"
+
+namespace joystickcontroller
+{
+
+inline VirtualControllerPool::VirtualControllerPool(const std::size_t numberOfControllers)
+	: m_numberOfControllers{ 0u }
+	, m_chunkSize{ 1024u }
+	, m_buttons{}
+	, m_axes{}
+	, m_axisPairs{}
+	, m_workers{}
+	, m_workMutex{}
+	, m_workStarted{}
+	, m_workFinished{}
+	, m_workGeneration{ 0u }
+	, m_numberOfBusyWorkers{ 0u }
+	, m_isStopping{ false }
+	, m_nextChunk{ 0u }
+	, m_numberOfChunks{ 0u }
+	, m_mathMode{ defaultMathMode }
+{
+	resize(numberOfControllers);
+}
+
+inline VirtualControllerPool::~VirtualControllerPool()
+{
+	priv_stopWorkers();
+}
+
+inline void VirtualControllerPool::resize(const std::size_t numberOfControllers)
+{
+	// new controllers have default calibration and are centred with no buttons pressed
+	m_numberOfControllers = numberOfControllers;
+	m_buttons.resize(numberOfControllers, 0u);
+	for (AxisStorage& axis : m_axes)
+	{
+		axis.raw.resize(numberOfControllers, 0.f);
+		axis.position.resize(numberOfControllers, 0.f);
+		axis.zero.resize(numberOfControllers, 0.f);
+		axis.minPositive.resize(numberOfControllers, 0.f);
+		axis.maxPositive.resize(numberOfControllers, 100.f);
+		axis.minNegative.resize(numberOfControllers, 0.f);
+		axis.maxNegative.resize(numberOfControllers, -100.f);
+	}
+	for (AxisPairStorage& axisPair : m_axisPairs)
+	{
+		axisPair.direction.resize(numberOfControllers, 0.f);
+		axisPair.strength.resize(numberOfControllers, 0.f);
+		axisPair.povHat.resize(numberOfControllers, -1);
+	}
+}
+
+inline std::size_t VirtualControllerPool::getSize() const
+{
+	return m_numberOfControllers;
+}
+
+inline void VirtualControllerPool::updatePhysical(const JoystickController& joystickController)
+{
+	// copies raw state and calibration of each connected joystick into the slot matching its joystick index
+	for (const std::size_t j : joystickController.getConnectedIndices())
+	{
+		if (j >= m_numberOfControllers)
+			continue;
+
+		std::uint64_t buttons{ 0u };
+		const std::size_t numberOfButtons{ std::min(joystickController.getButtonCount(j), maxButtonCount) };
+		for (std::size_t b{ 0u }; b < numberOfButtons; ++b)
+		{
+			if (joystickController.isButtonPressed(j, b))
+				buttons |= std::uint64_t{ 1u } << b;
+		}
+		m_buttons[j] = buttons;
+
+		for (std::size_t a{ 0u }; a < numberOfAxes; ++a)
+		{
+			const Axis axis{ static_cast<Axis>(a) };
+			AxisStorage& storage{ m_axes[a] };
+			storage.raw[j] = joystickController.getAxisPositionRaw(j, axis);
+			storage.zero[j] = joystickController.getCalibrationAxisZero(j, axis);
+			storage.minPositive[j] = joystickController.getCalibrationAxisMinPositive(j, axis);
+			storage.maxPositive[j] = joystickController.getCalibrationAxisMaxPositive(j, axis);
+			storage.minNegative[j] = joystickController.getCalibrationAxisMinNegative(j, axis);
+			storage.maxNegative[j] = joystickController.getCalibrationAxisMaxNegative(j, axis);
+		}
+	}
+}
+
+inline void VirtualControllerPool::update(std::size_t numberOfThreads, const MathMode mathMode)
+{
+	// zero threads uses the hardware concurrency; the calling thread is always one of the workers
+	// chunks are claimed dynamically so faster threads take on more of the work
+
+	if (numberOfThreads == 0u)
+		numberOfThreads = std::max(static_cast<std::size_t>(std::thread::hardware_concurrency()), static_cast<std::size_t>(1u));
+	priv_setNumberOfWorkers(numberOfThreads - 1u);
+
+	if (m_numberOfControllers == 0u)
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock{ m_workMutex };
+		m_nextChunk.store(0u, std::memory_order_relaxed);
+		m_numberOfChunks = (m_numberOfControllers + m_chunkSize - 1u) / m_chunkSize;
+		m_mathMode = mathMode;
+		m_numberOfBusyWorkers = m_workers.size();
+		++m_workGeneration;
+	}
+	m_workStarted.notify_all();
+
+	priv_processChunks();
+
+	std::unique_lock<std::mutex> lock{ m_workMutex };
+	m_workFinished.wait(lock, [this]() { return m_numberOfBusyWorkers == 0u; });
+}
+
+inline void VirtualControllerPool::setChunkSize(const std::size_t chunkSize)
+{
+	assert(chunkSize > 0u);
+
+	m_chunkSize = ((chunkSize + chunkAlignment - 1u) / chunkAlignment) * chunkAlignment;
+}
+
+inline std::size_t VirtualControllerPool::getChunkSize() const
+{
+	return m_chunkSize;
+}
+
+inline void VirtualControllerPool::setAxisPositionRaw(const std::size_t controllerIndex, const Axis axis, const float position)
+{
+	m_axes[static_cast<std::size_t>(axis)].raw[controllerIndex] = position;
+}
+
+inline void VirtualControllerPool::setButtonPressed(const std::size_t controllerIndex, const std::size_t buttonIndex, const bool isPressed)
+{
+	assert(buttonIndex < maxButtonCount);
+
+	if (isPressed)
+		m_buttons[controllerIndex] |= std::uint64_t{ 1u } << buttonIndex;
+	else
+		m_buttons[controllerIndex] &= ~(std::uint64_t{ 1u } << buttonIndex);
+}
+
+inline void VirtualControllerPool::setButtons(const std::size_t controllerIndex, const std::uint64_t buttons)
+{
+	m_buttons[controllerIndex] = buttons;
+}
+
+inline void VirtualControllerPool::setCalibrationAxisZero(const std::size_t controllerIndex, const Axis axis, const float zeroValue)
+{
+	m_axes[static_cast<std::size_t>(axis)].zero[controllerIndex] = zeroValue;
+}
+
+inline void VirtualControllerPool::setCalibrationAxisMinPositive(const std::size_t controllerIndex, const Axis axis, const float minPositive)
+{
+	m_axes[static_cast<std::size_t>(axis)].minPositive[controllerIndex] = minPositive;
+}
+
+inline void VirtualControllerPool::setCalibrationAxisMaxPositive(const std::size_t controllerIndex, const Axis axis, const float maxPositive)
+{
+	m_axes[static_cast<std::size_t>(axis)].maxPositive[controllerIndex] = maxPositive;
+}
+
+inline void VirtualControllerPool::setCalibrationAxisMinNegative(const std::size_t controllerIndex, const Axis axis, const float minNegative)
+{
+	m_axes[static_cast<std::size_t>(axis)].minNegative[controllerIndex] = minNegative;
+}
+
+inline void VirtualControllerPool::setCalibrationAxisMaxNegative(const std::size_t controllerIndex, const Axis axis, const float maxNegative)
+{
+	m_axes[static_cast<std::size_t>(axis)].maxNegative[controllerIndex] = maxNegative;
+}
+
+inline bool VirtualControllerPool::isButtonPressed(const std::size_t controllerIndex, const std::size_t buttonIndex) const
+{
+	if (buttonIndex >= maxButtonCount)
+		return false;
+	return (m_buttons[controllerIndex] & (std::uint64_t{ 1u } << buttonIndex)) != 0u;
+}
+
+inline std::uint64_t VirtualControllerPool::getButtons(const std::size_t controllerIndex) const
+{
+	return m_buttons[controllerIndex];
+}
+
+inline float VirtualControllerPool::getAxisPositionRaw(const std::size_t controllerIndex, const Axis axis) const
+{
+	return m_axes[static_cast<std::size_t>(axis)].raw[controllerIndex];
+}
+
+inline float VirtualControllerPool::getAxisPosition(const std::size_t controllerIndex, const Axis axis) const
+{
+	return m_axes[static_cast<std::size_t>(axis)].position[controllerIndex];
+}
+
+inline sf::Vector2f VirtualControllerPool::getAxis2dPosition(const std::size_t controllerIndex, const AxisPair axisPair) const
+{
+	const std::size_t axisPairIndex{ priv_getAxisPairIndex(axisPair) };
+	return { getAxisPosition(controllerIndex, priv_getAxisPairAxisX(axisPairIndex)), getAxisPosition(controllerIndex, priv_getAxisPairAxisY(axisPairIndex)) };
+}
+
+inline sf::Angle VirtualControllerPool::getAxis2dDirection(const std::size_t controllerIndex, const AxisPair axisPair) const
+{
+	return sf::radians(m_axisPairs[priv_getAxisPairIndex(axisPair)].direction[controllerIndex]);
+}
+
+inline float VirtualControllerPool::getAxis2dStrength(const std::size_t controllerIndex, const AxisPair axisPair) const
+{
+	return m_axisPairs[priv_getAxisPairIndex(axisPair)].strength[controllerIndex];
+}
+
+inline int VirtualControllerPool::getAxis2dAsPovHat(const std::size_t controllerIndex, const AxisPair axisPair) const
+{
+	return m_axisPairs[priv_getAxisPairIndex(axisPair)].povHat[controllerIndex];
+}
+
+inline const float* VirtualControllerPool::getAxisPositions(const Axis axis) const
+{
+	return m_axes[static_cast<std::size_t>(axis)].position.data();
+}
+
+inline const float* VirtualControllerPool::getAxis2dDirections(const AxisPair axisPair) const
+{
+	return m_axisPairs[priv_getAxisPairIndex(axisPair)].direction.data();
+}
+
+inline const float* VirtualControllerPool::getAxis2dStrengths(const AxisPair axisPair) const
+{
+	return m_axisPairs[priv_getAxisPairIndex(axisPair)].strength.data();
+}
+
+
+
+
+
+
+
+// PRIVATE
+
+inline void VirtualControllerPool::priv_setNumberOfWorkers(const std::size_t numberOfWorkers)
+{
+	if (m_workers.size() == numberOfWorkers)
+		return;
+
+	priv_stopWorkers();
+
+	// if a thread cannot be started, those already started are stopped (so none are left joinable) before rethrowing
+	m_workers.reserve(numberOfWorkers);
+	try
+	{
+		for (std::size_t w{ 0u }; w < numberOfWorkers; ++w)
+			m_workers.emplace_back(&VirtualControllerPool::priv_runWorker, this, m_workGeneration);
+	}
+	catch (...)
+	{
+		priv_stopWorkers();
+		throw;
+	}
+}
+
+inline void VirtualControllerPool::priv_stopWorkers()
+{
+	{
+		std::lock_guard<std::mutex> lock{ m_workMutex };
+		m_isStopping = true;
+	}
+	m_workStarted.notify_all();
+	for (std::thread& worker : m_workers)
+		worker.join();
+	m_workers.clear();
+	m_isStopping = false;
+}
+
+inline void VirtualControllerPool::priv_runWorker(std::size_t workGeneration)
+{
+	for (;;)
+	{
+		{
+			std::unique_lock<std::mutex> lock{ m_workMutex };
+			m_workStarted.wait(lock, [this, workGeneration]() { return m_isStopping || (m_workGeneration != workGeneration); });
+			if (m_isStopping)
+				return;
+			workGeneration = m_workGeneration;
+		}
+
+		priv_processChunks();
+
+		bool isLastWorker{ false };
+		{
+			std::lock_guard<std::mutex> lock{ m_workMutex };
+			isLastWorker = (--m_numberOfBusyWorkers == 0u);
+		}
+		if (isLastWorker)
+			m_workFinished.notify_one();
+	}
+}
+
+inline void VirtualControllerPool::priv_processChunks()
+{
+	for (std::size_t chunk{ m_nextChunk.fetch_add(1u, std::memory_order_relaxed) }; chunk < m_numberOfChunks; chunk = m_nextChunk.fetch_add(1u, std::memory_order_relaxed))
+	{
+		const std::size_t begin{ chunk * m_chunkSize };
+		priv_updateRange(begin, std::min(begin + m_chunkSize, m_numberOfControllers), m_mathMode);
+	}
+}
+
+inline void VirtualControllerPool::priv_updateRange(const std::size_t begin, const std::size_t end, const MathMode mathMode)
+{
+	for (AxisStorage& axis : m_axes)
+	{
+		for (std::size_t i{ begin }; i < end; ++i)
+			axis.position[i] = JoystickController::priv_calibrateAxisPosition(axis.raw[i], axis.zero[i], axis.minPositive[i], axis.maxPositive[i], axis.minNegative[i], axis.maxNegative[i]);
+	}
+
+	for (std::size_t p{ 0u }; p < numberOfAxisPairs; ++p)
+	{
+		AxisPairStorage& axisPair{ m_axisPairs[p] };
+		const float* const positionsX{ m_axes[static_cast<std::size_t>(priv_getAxisPairAxisX(p))].position.data() };
+		const float* const positionsY{ m_axes[static_cast<std::size_t>(priv_getAxisPairAxisY(p))].position.data() };
+
+		// same results as JoystickController's getAxis2dDirection and getAxis2dStrength
+		if (mathMode == MathMode::Fast)
+		{
+			fastmath::computeDirections(positionsX + begin, positionsY + begin, axisPair.direction.data() + begin, end - begin);
+			fastmath::computeStrengths(positionsX + begin, positionsY + begin, axisPair.strength.data() + begin, end - begin);
+		}
+		else
+		{
+			for (std::size_t i{ begin }; i < end; ++i)
+			{
+				axisPair.direction[i] = std::atan2(positionsX[i], -positionsY[i]) - JoystickController::halfPiFloat;
+				const float strength{ std::sqrt(positionsX[i] * positionsX[i] + positionsY[i] * positionsY[i]) * 0.01f };
+				axisPair.strength[i] = (strength > 1.f) ? 1.f : strength;
+			}
+		}
+
+		// same results as JoystickController's getAxis2dAsPovHat
+		constexpr float recipricalOfFullCircle{ 1.f / JoystickController::doublePiFloat };
+		for (std::size_t i{ begin }; i < end; ++i)
+		{
+			if (axisPair.strength[i] < 0.5f)
+			{
+				axisPair.povHat[i] = -1;
+				continue;
+			}
+			float angle{ axisPair.direction[i] + JoystickController::halfPiFloat }; // add quarter turn so that first index is straight up
+			while (angle > JoystickController::doublePiFloat)
+				angle -= JoystickController::doublePiFloat;
+			while (angle < 0.f)
+				angle += JoystickController::doublePiFloat;
+			angle *= 8.f * recipricalOfFullCircle;
+			int directionIndex{ static_cast<int>(std::round(angle)) };
+			if (directionIndex >= 8)
+				directionIndex -= 8;
+			axisPair.povHat[i] = directionIndex;
+		}
+	}
+}
+
+inline std::size_t VirtualControllerPool::priv_getAxisPairIndex(const AxisPair axisPair)
+{
+	switch (axisPair)
+	{
+	default:
+	case AxisPair::XY:
+		return 0u;
+	case AxisPair::UV:
+		return 1u;
+	case AxisPair::PovXY:
+		return 2u;
+	}
+}
+
+inline Axis VirtualControllerPool::priv_getAxisPairAxisX(const std::size_t axisPairIndex)
+{
+	switch (axisPairIndex)
+	{
+	default:
+	case 0u:
+		return Axis::X;
+	case 1u:
+		return Axis::U;
+	case 2u:
+		return Axis::PovX;
+	}
+}
+
+inline Axis VirtualControllerPool::priv_getAxisPairAxisY(const std::size_t axisPairIndex)
+{
+	switch (axisPairIndex)
+	{
+	default:
+	case 0u:
+		return Axis::Y;
+	case 1u:
+		return Axis::V;
+	case 2u:
+		return Axis::PovY;
+	}
+}
+
+} // namespace joystickcontroller
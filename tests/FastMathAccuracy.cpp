@@ -0,0 +1,123 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Joystick Controller (https://github.com/Hapaxia/JoystickController
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+// exhaustive accuracy test of fastmath against the precise maths used by JoystickController
+// sweeps the full calibrated grid (-100 to 100 on both axes, in steps of 0.25) and checks the documented error bounds
+// only needs FastMath (not SFML); for example: g++ -std=c++17 -O2 FastMathAccuracy.cpp -o FastMathAccuracy
+// returns zero on success
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "../JoystickController/FastMath.hpp"
+
+namespace
+{
+
+constexpr float halfPiFloat{ 3.141592653f / 2.f };
+constexpr double maxDirectionError{ 1.2e-5 }; // radians
+constexpr double maxStrengthError{ 0.002 };
+constexpr double maxRelativeSqrtError{ 0.0018 };
+
+// same as JoystickController::getAxis2dDirectionCustomAxisPair with MathMode::Precise
+float getPreciseDirection(const float x, const float y)
+{
+	return std::atan2(x, -y) - halfPiFloat;
+}
+
+// same as JoystickController::getAxis2dStrengthCustomAxisPair with MathMode::Precise
+float getPreciseStrength(const float x, const float y)
+{
+	float strength{ std::sqrt(x * x + y * y) * 0.01f };
+	if (strength < 0.f)
+		strength = 0.f;
+	if (strength > 1.f)
+		strength = 1.f;
+	return strength;
+}
+
+} // namespace
+
+int main()
+{
+	namespace fastmath = joystickcontroller::fastmath;
+
+	std::vector<float> positionsX{};
+	std::vector<float> positionsY{};
+	for (int i{ -400 }; i <= 400; ++i)
+	{
+		for (int j{ -400 }; j <= 400; ++j)
+		{
+			positionsX.push_back(i * 0.25f);
+			positionsY.push_back(j * 0.25f);
+		}
+	}
+	const std::size_t count{ positionsX.size() };
+
+	std::vector<float> directions(count);
+	std::vector<float> strengths(count);
+	fastmath::computeDirections(positionsX.data(), positionsY.data(), directions.data(), count);
+	fastmath::computeStrengths(positionsX.data(), positionsY.data(), strengths.data(), count);
+
+	double worstDirectionError{ 0.0 };
+	double worstStrengthError{ 0.0 };
+	double worstRelativeSqrtError{ 0.0 };
+	std::size_t numberOfBatchMismatches{ 0u };
+	for (std::size_t i{ 0u }; i < count; ++i)
+	{
+		const float x{ positionsX[i] };
+		const float y{ positionsY[i] };
+
+		const float direction{ fastmath::atan2(x, -y) - halfPiFloat };
+		const float strength{ std::fmin(fastmath::sqrt(x * x + y * y) * 0.01f, 1.f) };
+		if ((direction != directions[i]) || (strength != strengths[i]))
+			++numberOfBatchMismatches;
+
+		worstDirectionError = std::fmax(worstDirectionError, std::fabs(static_cast<double>(direction) - getPreciseDirection(x, y)));
+		worstStrengthError = std::fmax(worstStrengthError, std::fabs(static_cast<double>(strength) - getPreciseStrength(x, y)));
+
+		const float lengthSquared{ x * x + y * y };
+		if (lengthSquared > 0.f)
+			worstRelativeSqrtError = std::fmax(worstRelativeSqrtError, std::fabs(fastmath::sqrt(lengthSquared) / std::sqrt(static_cast<double>(lengthSquared)) - 1.0));
+		else if (fastmath::sqrt(lengthSquared) != 0.f)
+			++numberOfBatchMismatches;
+	}
+
+	std::printf("points tested: %zu\n", count);
+	std::printf("direction: max error %g radians (limit %g)\n", worstDirectionError, maxDirectionError);
+	std::printf("strength: max error %g (limit %g)\n", worstStrengthError, maxStrengthError);
+	std::printf("sqrt: max relative error %g (limit %g)\n", worstRelativeSqrtError, maxRelativeSqrtError);
+	std::printf("batch/scalar mismatches: %zu\n", numberOfBatchMismatches);
+
+	const bool isPassed{ (worstDirectionError <= maxDirectionError) && (worstStrengthError <= maxStrengthError) && (worstRelativeSqrtError <= maxRelativeSqrtError) && (numberOfBatchMismatches == 0u) };
+	std::printf(isPassed ? "PASSED\n" : "FAILED\n");
+	return isPassed ? 0 : 1;
+}
@@ -0,0 +1,171 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Joystick Controller (https://github.com/Hapaxia/JoystickController
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+// loopback test of InputHistory encoding: frames are encoded from one history and decoded into another (as if sent over a network)
+// checks the round trip (including buttons above 31), truncated buffers, ranges with skipped frames and clear()
+// needs the SFML headers (but not its libraries); for example: g++ -std=c++17 -I<SFML include> InputHistoryLoopback.cpp -o InputHistoryLoopback
+// returns zero on success
+
+#include <cstdio>
+#include <vector>
+
+#include "../JoystickController/InputHistory.hpp"
+
+namespace
+{
+
+using joystickcontroller::InputFrame;
+using joystickcontroller::InputHistory;
+
+std::size_t numberOfFailures{ 0u };
+
+void check(const bool isPassed, const char* const description)
+{
+	if (isPassed)
+		return;
+	++numberOfFailures;
+	std::printf("failed: %s\n", description);
+}
+
+InputFrame makeFrame(const std::uint32_t frameNumber)
+{
+	// varies every axis and sets buttons throughout the 64-bit mask (some frames repeat the previous frame's buttons)
+	InputFrame frame{};
+	frame.frameNumber = frameNumber;
+	for (std::size_t a{ 0u }; a < frame.axes.size(); ++a)
+		frame.axes[a] = static_cast<std::int8_t>(static_cast<int>((frameNumber * (a + 3u) + a * 17u) % 201u) - 100);
+	const std::uint64_t pattern{ (frameNumber / 2u) * 0x9E3779B97F4A7C15u };
+	frame.buttons = pattern | (std::uint64_t{ 1u } << (32u + frameNumber % 32u));
+	return frame;
+}
+
+bool isSameFrame(const InputFrame& a, const InputFrame& b)
+{
+	return (a.frameNumber == b.frameNumber) && (a.buttons == b.buttons) && (a.axes == b.axes);
+}
+
+void testRoundTrip()
+{
+	InputHistory sender{ 64u };
+	for (std::uint32_t f{ 1000u }; f < 1100u; ++f)
+		sender.push(makeFrame(f));
+
+	std::vector<std::uint8_t> buffer{};
+	check(sender.encode(1040u, 1099u, buffer), "round trip: encode");
+
+	InputHistory receiver{ 64u };
+	check(receiver.decode(buffer) == buffer.size(), "round trip: decode consumes the whole buffer");
+	check((receiver.getFirstFrameNumber() == 1040u) && (receiver.getLastFrameNumber() == 1099u), "round trip: frame range");
+	bool areAllFramesSame{ true };
+	bool hasHighButtons{ false };
+	for (std::uint32_t f{ 1040u }; f <= 1099u; ++f)
+	{
+		if (!receiver.hasFrame(f) || !isSameFrame(receiver.getFrame(f), sender.getFrame(f)))
+			areAllFramesSame = false;
+		else if ((receiver.getFrame(f).buttons >> 32u) != 0u)
+			hasHighButtons = true;
+	}
+	check(areAllFramesSame, "round trip: every frame is reproduced");
+	check(hasHighButtons && InputHistory::isButtonPressed(receiver.getFrame(1050u), 32u + 1050u % 32u), "round trip: buttons above 31 are reproduced");
+}
+
+void testTruncation()
+{
+	InputHistory sender{ 32u };
+	for (std::uint32_t f{ 0u }; f < 20u; ++f)
+		sender.push(makeFrame(f));
+
+	std::vector<std::uint8_t> buffer{};
+	check(sender.encode(0u, 19u, buffer), "truncation: encode");
+
+	bool areAllRejected{ true };
+	for (std::size_t size{ 0u }; size < buffer.size(); ++size)
+	{
+		InputHistory receiver{ 32u };
+		if ((receiver.decode(buffer.data(), size) != 0u) || !receiver.isEmpty())
+			areAllRejected = false;
+	}
+	check(areAllRejected, "truncation: every truncated prefix decodes to 0 and pushes nothing");
+}
+
+void testSkippedFrame()
+{
+	InputHistory sender{ 32u };
+	for (std::uint32_t f{ 0u }; f < 20u; ++f)
+	{
+		if (f != 10u)
+			sender.push(makeFrame(f));
+	}
+
+	std::vector<std::uint8_t> buffer{ 1u, 2u, 3u };
+	check(!sender.encode(5u, 15u, buffer), "skipped frame: encode fails");
+	check(buffer == std::vector<std::uint8_t>{ 1u, 2u, 3u }, "skipped frame: buffer is untouched");
+	check(sender.encode(11u, 19u, buffer) && (buffer.size() > 3u), "skipped frame: encode succeeds after the skipped frame");
+}
+
+void testClear()
+{
+	InputHistory history{ 16u };
+	for (std::uint32_t f{ 0u }; f < 40u; ++f)
+		history.push(makeFrame(f));
+	history.clear();
+
+	bool hasStaleFrame{ false };
+	for (std::uint32_t f{ 0u }; f < 80u; ++f)
+	{
+		if (history.hasFrame(f))
+			hasStaleFrame = true;
+	}
+	check(history.isEmpty() && !hasStaleFrame, "clear: no frames remain");
+
+	// frames pushed after clearing span slots still holding the frames pushed before clearing
+	history.push(makeFrame(30u));
+	history.push(makeFrame(39u));
+	hasStaleFrame = false;
+	for (std::uint32_t f{ 0u }; f < 80u; ++f)
+	{
+		if ((f != 30u) && (f != 39u) && history.hasFrame(f))
+			hasStaleFrame = true;
+	}
+	check(history.hasFrame(30u) && history.hasFrame(39u) && !hasStaleFrame, "clear: only frames pushed after clearing are held");
+}
+
+} // namespace
+
+int main()
+{
+	testRoundTrip();
+	testTruncation();
+	testSkippedFrame();
+	testClear();
+
+	std::printf(numberOfFailures == 0u ? "PASSED\n" : "FAILED\n");
+	return numberOfFailures == 0u ? 0 : 1;
+}